@@ -0,0 +1,26 @@
+#-----------------------------------------------------------------------------------------------------------------------------------
+#
+# PROJECT:            Engineering Workshop Tracker (engineeringShop)
+# FILE:								benchmark.pro
+# SUBSYSTEM:          Project File - MariaDB connector benchmarks
+# LANGUAGE:						C++
+# TARGET OS:          LINUX
+# LIBRARY DEPENDANCE:	None.
+# NAMESPACE:          N/A
+# AUTHOR:							Gavin Blakeman.
+# LICENSE:            GPLv2
+#
+#                     Copyright 2026 Gavin Blakeman.
+#
+# OVERVIEW:						Builds the benchmark executables of the connector.
+#
+# HISTORY:            2026-10-19/GGB - File Created
+#
+#-----------------------------------------------------------------------------------------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+  cacheLayoutBenchmark.pro \
+  loadGenerator.pro \
+  temporalBenchmark.pro
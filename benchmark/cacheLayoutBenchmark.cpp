@@ -0,0 +1,265 @@
+﻿#include "mysql/mysql.h"
+
+  // Standard C++ library
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* Cache layout benchmark for the per-handle state of CMariaDBConnector.
+ *
+ * Each thread walks rows on its own handle, updating the cursor state the way loadRow() and processMoveNext() do, and
+ * starts a new query every few rows, writing the statement buffer the way parameterQuery() does. The handles are adjacent
+ * entries of one vector, as in connectionPool. Nothing is shared between the threads, so any loss of scaling is false
+ * sharing between neighbouring handles.
+ *
+ * Three layouts are compared. They mirror the fields of connection_t, as the connector's types are private:
+ *   legacy:     the single connection_t before the hot/cold split. Hot cursor fields of one handle share a cache line with
+ *               the statement buffers at the end of the previous handle.
+ *   split:      the hot/cold split without cache line alignment. The hot blocks are smaller than a line and pack together.
+ *   aligned:    the hot/cold split with each block aligned to a cache line, as used by the connector.
+ *
+ * Usage:
+ *   cacheLayoutBenchmark [--threads 1,2,4,8] [--rows rows per thread] [--query rows per query]
+ */
+
+namespace
+{
+  std::size_t const CACHE_LINE_SIZE = 64;
+
+  struct shape_t
+  {
+    std::uint32_t useCount = 0;
+    bool resultKnown = false;
+    bool returnsRows = false;
+    bool promotable = true;
+  };
+
+  /// @brief The cursor and flag fields written on each row.
+
+#define CURSOR_FIELDS \
+  MYSQL *mysql = nullptr; \
+  MYSQL_RES *mysql_res = nullptr; \
+  MYSQL_FIELD *mysql_field = nullptr; \
+  MYSQL_ROW mysql_row = nullptr; \
+  unsigned long *columnLengths = nullptr; \
+  std::uint64_t rowCount = 0; \
+  std::uint64_t rowCursorActual = 0; \
+  std::uint64_t rowCursorRequested = 0; \
+  unsigned int columnCount = 0; \
+  bool validRecord = false;
+
+  /// @brief connection_t before the hot/cold split.
+
+  struct legacyConnection_t
+  {
+    CURSOR_FIELDS
+    std::vector<MYSQL_ROW_OFFSET> rowOffsets;
+    std::unordered_map<std::string, std::unique_ptr<int>> statementCache;
+    void *statement = nullptr;
+    std::size_t bindIndex = 0;
+    std::vector<void *> outputParameters;
+    std::unordered_map<std::string, shape_t> shapeCache;
+    std::string sqlBuffer;
+    std::string valueBuffer;
+    std::chrono::milliseconds queryTimeout{0};
+    std::chrono::steady_clock::time_point queryDeadline = std::chrono::steady_clock::time_point::max();
+    bool queryKilled = false;
+
+    std::string &statementBuffer() { return sqlBuffer; }
+  };
+
+  /// @brief connectionCold_t, with the given alignment.
+
+  template<std::size_t Alignment>
+  struct alignas(Alignment) coldConnection_t
+  {
+    std::vector<MYSQL_ROW_OFFSET> rowOffsets;
+    std::unordered_map<std::string, std::unique_ptr<int>> statementCache;
+    std::vector<void *> outputParameters;
+    std::unordered_map<std::string, shape_t> shapeCache;
+    std::string sqlBuffer;
+    std::string valueBuffer;
+    std::chrono::milliseconds queryTimeout{0};
+    std::chrono::steady_clock::time_point queryDeadline = std::chrono::steady_clock::time_point::max();
+    bool queryKilled = false;
+  };
+
+  /// @brief connection_t after the hot/cold split, with the given alignment.
+
+  template<std::size_t Alignment>
+  struct alignas(Alignment) splitConnection_t
+  {
+    CURSOR_FIELDS
+    void *statement = nullptr;
+    std::size_t bindIndex = 0;
+    std::atomic<std::thread::id> owner;
+    std::unique_ptr<coldConnection_t<Alignment>> cold = std::make_unique<coldConnection_t<Alignment>>();
+
+    std::string &statementBuffer() { return cold->sqlBuffer; }
+  };
+
+#undef CURSOR_FIELDS
+
+  using packedConnection_t = splitConnection_t<alignof(std::uint64_t)>;
+  using alignedConnection_t = splitConnection_t<CACHE_LINE_SIZE>;
+
+  /// @brief Moves to the next row of the current result, or runs the next query at the end of the result. Not inlined, so
+  ///        that each row writes the handle's memory rather than registers.
+
+  template<typename Connection>
+  [[gnu::noinline]] void nextRow(Connection &connection, MYSQL_ROW rows, unsigned long *lengths)
+  {
+    if (++connection.rowCursorRequested < connection.rowCount)
+    {
+      connection.mysql_row = rows + (connection.rowCursorRequested & 7);
+      connection.columnLengths = lengths;
+      connection.rowCursorActual = connection.rowCursorRequested + 1;
+      connection.validRecord = true;
+    }
+    else
+    {
+      connection.statementBuffer().assign("SELECT id, reading FROM readings WHERE id = 42");
+      connection.rowCursorRequested = 0;
+      connection.rowCursorActual = 0;
+      connection.validRecord = false;
+    };
+  }
+
+  /// @brief Walks rows on one handle per thread.
+  /// @returns Rows per second over all threads.
+
+  template<typename Connection>
+  double runLayout(std::size_t threadCount, std::uint64_t rows, std::uint64_t queryRows)
+  {
+    std::vector<Connection> pool(threadCount);
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool> start{false};
+
+    for (auto &connection : pool)
+    {
+      connection.rowCount = queryRows;
+    };
+
+    for (std::size_t index = 0; index < threadCount; ++index)
+    {
+      threads.emplace_back([&pool, &ready, &start, index, rows]
+      {
+        char *values[8] = {};
+        unsigned long lengths[8] = {};
+
+        ready.fetch_add(1);
+        while (!start.load())
+        {
+          std::this_thread::yield();
+        };
+
+        for (std::uint64_t row = 0; row < rows; ++row)
+        {
+          nextRow(pool[index], values, lengths);
+        };
+      });
+    };
+
+    while (ready.load() != threadCount)
+    {
+      std::this_thread::yield();
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    start.store(true);
+    for (auto &thread : threads)
+    {
+      thread.join();
+    };
+
+    return threadCount * rows / std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  }
+
+  /// @brief Parses a comma separated list of numbers.
+
+  std::vector<std::size_t> parseList(std::string const &text)
+  {
+    std::vector<std::size_t> returnValue;
+    std::size_t position = 0;
+
+    while (position < text.size())
+    {
+      std::size_t end = text.find(',', position);
+
+      if (end == std::string::npos)
+      {
+        end = text.size();
+      };
+      returnValue.push_back(std::stoul(text.substr(position, end - position)));
+      position = end + 1;
+    };
+
+    return returnValue;
+  }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  std::vector<std::size_t> threadCounts{1, 2, 4, 8};
+  std::uint64_t rows = 50000000;
+  std::uint64_t queryRows = 16;
+
+  try
+  {
+    for (int index = 1; index + 1 < argc; index += 2)
+    {
+      std::string argument = argv[index];
+
+      if (argument == "--threads")
+      {
+        threadCounts = parseList(argv[index + 1]);
+      }
+      else if (argument == "--rows")
+      {
+        rows = std::stoull(argv[index + 1]);
+      }
+      else if (argument == "--query")
+      {
+        queryRows = std::stoull(argv[index + 1]);
+      }
+      else
+      {
+        throw std::runtime_error("Unknown option " + argument);
+      };
+    };
+
+    std::printf("entry size: legacy %zu, split %zu, aligned %zu bytes\n", sizeof(legacyConnection_t),
+                sizeof(packedConnection_t), sizeof(alignedConnection_t));
+    std::printf("%zu rows per thread, %zu rows per query\n", static_cast<std::size_t>(rows),
+                static_cast<std::size_t>(queryRows));
+    std::printf("%8s %16s %16s %16s\n", "threads", "legacy (Mrow/s)", "split (Mrow/s)", "aligned (Mrow/s)");
+
+    for (std::size_t threadCount : threadCounts)
+    {
+      std::printf("%8zu %16.1f %16.1f %16.1f\n", threadCount,
+                  runLayout<legacyConnection_t>(threadCount, rows, queryRows) / 1e6,
+                  runLayout<packedConnection_t>(threadCount, rows, queryRows) / 1e6,
+                  runLayout<alignedConnection_t>(threadCount, rows, queryRows) / 1e6);
+    };
+  }
+  catch(std::exception const &e)
+  {
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
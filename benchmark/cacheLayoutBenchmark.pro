@@ -0,0 +1,35 @@
+#-----------------------------------------------------------------------------------------------------------------------------------
+#
+# PROJECT:            Engineering Workshop Tracker (engineeringShop)
+# FILE:								cacheLayoutBenchmark.pro
+# SUBSYSTEM:          Project File - MariaDB connector cache layout benchmark
+# LANGUAGE:						C++
+# TARGET OS:          LINUX
+# LIBRARY DEPENDANCE:	None.
+# NAMESPACE:          N/A
+# AUTHOR:							Gavin Blakeman.
+# LICENSE:            GPLv2
+#
+#                     Copyright 2026 Gavin Blakeman.
+#
+# OVERVIEW:						Project file for the per-handle cache layout benchmark.
+#
+# HISTORY:            2026-10-19/GGB - File Created
+#
+#-----------------------------------------------------------------------------------------------------------------------------------
+
+TARGET = cacheLayoutBenchmark
+
+TEMPLATE = app
+
+QT -= core gui
+
+CONFIG += cmdline
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS += -std=c++20 -O2
+
+SOURCES += \
+  cacheLayoutBenchmark.cpp
+
+LIBS += -lpthread
@@ -0,0 +1,535 @@
+﻿#include "include/database_mariadb.h"
+
+  // Standard C++ library
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+  // plugin_database_mariadb
+
+#include "include/latencyHistogram.h"
+
+/* Load generator for CMariaDBConnector.
+ *
+ * Drives the connector from a number of threads against a local server with a configurable mix of operations, and reports
+ * throughput and latency for each combination of thread count and pool size:
+ *
+ *   point:        SELECT of one row by primary key, decoded with typedQuery().
+ *   transaction:  UPDATE of one row and INSERT of one event, between the pool's beginTransaction() and
+ *                 commitTransaction(). The handle is held by the transaction claim throughout, and the time from begin to
+ *                 commit or rollback is reported as the transaction phase.
+ *   bulk:         SELECT of 1000 consecutive rows, decoded with typedQuery().
+ *   insert:       INSERT of one event through parameterQuery(), which is promoted to a cached prepared statement.
+ *
+ * Threads take a free handle for each operation, so with more threads than handles the wait for a handle is part of the
+ * latency, as it is for an application sizing its pool. Each thread is attached to the client library on first use and
+ * claims the handle per operation.
+ *
+ * Usage:
+ *   loadGenerator [--host localhost] [--port 3306] [--user user] [--password password] [--schema loadTest]
+ *                 [--setup rows] [--rows rows] [--threads 1,2,4,8] [--pool 4,16] [--seconds 10] [--warmup 2]
+ *                 [--mix point=70,transaction=10,bulk=5,insert=15]
+ */
+
+namespace
+{
+  using namespace database;
+
+  enum operation_e
+  {
+    OP_POINT,
+    OP_TRANSACTION,
+    OP_BULK,
+    OP_INSERT,
+    OP_COUNT,
+  };
+
+  char const *const OPERATION_NAMES[OP_COUNT] = {"point", "transaction", "bulk", "insert"};
+  char const *const PHASE_NAMES[PHASE_COUNT] = {"execute", "fetch", "decode", "transaction"};
+
+  std::uint32_t const BULK_ROWS = 1000;
+
+  using reading_t = std::tuple<std::uint32_t, std::uint32_t, double, Wt::WDateTime>;
+
+  struct options_t
+  {
+    std::string host = "localhost";
+    unsigned int port = 3306;
+    std::string user;
+    std::string password;
+    std::string schema = "loadTest";
+    std::uint32_t setupRows = 0;          ///< Rows to create. 0 to use the existing table.
+    std::uint32_t tableRows = 100000;     ///< Rows in the existing table.
+    std::vector<std::size_t> threads{1, 2, 4, 8};
+    std::vector<std::size_t> poolSizes{4, 16};
+    std::chrono::seconds duration{10};
+    std::chrono::seconds warmup{2};
+    std::array<unsigned int, OP_COUNT> mix{70, 10, 5, 15};
+  };
+
+  /// @brief Connector with the connection details set directly rather than from the application configuration.
+
+  class CLoadConnector : public CMariaDBConnector
+  {
+  public:
+    CLoadConnector(handle_t poolSize, options_t const &options) : CMariaDBConnector(poolSize)
+    {
+      host_ = options.host;
+      port_ = options.port;
+      user_ = options.user;
+      passwd_ = options.password;
+      schema_ = options.schema;
+    }
+  };
+
+  /// @brief The free handles of the pool. Threads wait for a handle when all are in use.
+
+  class CHandleQueue
+  {
+  private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<handle_t> freeHandles;
+
+  public:
+    CHandleQueue(handle_t poolSize)
+    {
+      for (handle_t handle = 0; handle < poolSize; ++handle)
+      {
+        freeHandles.push_back(handle);
+      };
+    }
+
+    handle_t acquire()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      condition.wait(lock, [this] { return !freeHandles.empty(); });
+
+      handle_t returnValue = freeHandles.back();
+      freeHandles.pop_back();
+      return returnValue;
+    }
+
+    void release(handle_t handle)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeHandles.push_back(handle);
+      }
+      condition.notify_one();
+    }
+  };
+
+  /// @brief Results of one thread count and pool size.
+
+  struct run_t
+  {
+    std::array<CLatencyHistogram, OP_COUNT> latency;
+    CLatencyHistogram all;
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<bool> measuring{false};
+    std::atomic<bool> stop{false};
+  };
+
+  /// @brief Parses a comma separated list of numbers.
+
+  std::vector<std::size_t> parseList(std::string const &text)
+  {
+    std::vector<std::size_t> returnValue;
+    std::size_t position = 0;
+
+    while (position < text.size())
+    {
+      std::size_t end = text.find(',', position);
+
+      if (end == std::string::npos)
+      {
+        end = text.size();
+      };
+      returnValue.push_back(std::stoul(text.substr(position, end - position)));
+      position = end + 1;
+    };
+
+    return returnValue;
+  }
+
+  /// @brief Parses the operation mix. Operations not listed have a weight of zero.
+
+  std::array<unsigned int, OP_COUNT> parseMix(std::string const &text)
+  {
+    std::array<unsigned int, OP_COUNT> returnValue{};
+    std::size_t position = 0;
+
+    while (position < text.size())
+    {
+      std::size_t end = text.find(',', position);
+      std::size_t equals = text.find('=', position);
+
+      if (end == std::string::npos)
+      {
+        end = text.size();
+      };
+      if ((equals == std::string::npos) || (equals > end))
+      {
+        throw std::runtime_error("Invalid mix: " + text);
+      };
+
+      std::string name = text.substr(position, equals - position);
+      std::size_t operation = 0;
+
+      while ((operation < OP_COUNT) && (name != OPERATION_NAMES[operation]))
+      {
+        ++operation;
+      };
+      if (operation == OP_COUNT)
+      {
+        throw std::runtime_error("Unknown operation: " + name);
+      };
+
+      returnValue[operation] = std::stoul(text.substr(equals + 1, end - equals - 1));
+      position = end + 1;
+    };
+
+    return returnValue;
+  }
+
+  /// @brief A date-time that varies with the row, so the decode does not see the same value each time.
+
+  Wt::WDateTime recordedTime(std::uint32_t id)
+  {
+    return Wt::WDateTime(Wt::WDate(2024, 1 + id % 12, 1 + id % 28), Wt::WTime(id % 24, id % 60, (id / 60) % 60, id % 1000));
+  }
+
+  /// @brief Creates the tables and loads the readings with bulkLoad().
+
+  void setupTables(options_t const &options)
+  {
+    CLoadConnector connector(1, options);
+
+    connector.parameterQuery(0, "DROP TABLE IF EXISTS loadReadings", {});
+    connector.parameterQuery(0, "DROP TABLE IF EXISTS loadEvents", {});
+    connector.parameterQuery(0, "CREATE TABLE loadReadings (id INT UNSIGNED NOT NULL PRIMARY KEY, "
+                                "machine INT UNSIGNED NOT NULL, reading DOUBLE NOT NULL, recorded DATETIME(6) NOT NULL) "
+                                "ENGINE=InnoDB", {});
+    connector.parameterQuery(0, "CREATE TABLE loadEvents (id BIGINT UNSIGNED NOT NULL AUTO_INCREMENT PRIMARY KEY, "
+                                "machine INT UNSIGNED NOT NULL, reading DOUBLE NOT NULL, recorded DATETIME(6) NOT NULL) "
+                                "ENGINE=InnoDB", {});
+
+    std::uint32_t id = 0;
+    std::uint64_t rows = connector.bulkLoad(0, "loadReadings", {"id", "machine", "reading", "recorded"},
+                                            [&id, &options](CRecord &record) -> bool
+    {
+      if (id >= options.setupRows)
+      {
+        return false;
+      };
+
+      record.clear();
+      record.setValue(0, CVariant(id));
+      record.setValue(1, CVariant(id % 64));
+      record.setValue(2, CVariant(id * 0.25));
+      record.setValue(3, CVariant(recordedTime(id)));
+      ++id;
+      return true;
+    });
+
+    std::cout << "Loaded " << rows << " rows." << std::endl;
+  }
+
+  /// @brief Runs one operation on a handle.
+
+  void runOperation(CLoadConnector &connector, handle_t handle, operation_e operation, std::mt19937 &random,
+                    std::uint32_t tableRows)
+  {
+    std::uint32_t id = random() % tableRows;
+    std::uint32_t machine = id % 64;
+
+    switch (operation)
+    {
+      case OP_POINT:
+      {
+        connector.typedQuery<reading_t>(handle, "SELECT id, machine, reading, recorded FROM loadReadings WHERE id = " +
+                                                std::to_string(id));
+        break;
+      }
+      case OP_TRANSACTION:
+      {
+        connector.beginTransaction(handle);
+        try
+        {
+          connector.parameterQuery(handle, "UPDATE loadReadings SET reading = reading + 1 WHERE id = ?", {CVariant(id)});
+          connector.parameterQuery(handle, "INSERT INTO loadEvents (machine, reading, recorded) VALUES (?, ?, ?)",
+                                   {CVariant(machine), CVariant(1.0), CVariant(recordedTime(id))});
+          connector.commitTransaction(handle);
+        }
+        catch(...)
+        {
+          try
+          {
+            connector.rollbackTransaction(handle);
+          }
+          catch(...)
+          {
+              // The error that caused the rollback is the one reported.
+          }
+          throw;
+        }
+        break;
+      }
+      case OP_BULK:
+      {
+        std::uint32_t first = (tableRows > BULK_ROWS) ? id % (tableRows - BULK_ROWS) : 0;
+
+        connector.typedQuery<reading_t>(handle, "SELECT id, machine, reading, recorded FROM loadReadings WHERE id BETWEEN " +
+                                                std::to_string(first) + " AND " + std::to_string(first + BULK_ROWS - 1));
+        break;
+      }
+      case OP_INSERT:
+      {
+        connector.parameterQuery(handle, "INSERT INTO loadEvents (machine, reading, recorded) VALUES (?, ?, ?)",
+                                 {CVariant(machine), CVariant(id * 0.5), CVariant(recordedTime(id))});
+        break;
+      }
+      default:
+      {
+        break;
+      }
+    };
+  }
+
+  /// @brief Load thread. Runs operations chosen by the mix until stopped.
+
+  void loadThread(CLoadConnector &connector, CHandleQueue &handles, options_t const &options, run_t &run, unsigned int seed)
+  {
+    std::mt19937 random(seed);
+    std::discrete_distribution<int> chooseOperation(options.mix.begin(), options.mix.end());
+
+    while (!run.stop.load(std::memory_order_relaxed))
+    {
+      operation_e operation = static_cast<operation_e>(chooseOperation(random));
+      auto startTime = std::chrono::steady_clock::now();
+      handle_t handle = handles.acquire();
+
+      try
+      {
+        runOperation(connector, handle, operation, random, options.tableRows);
+      }
+      catch(std::exception const &e)
+      {
+        if (run.errors.fetch_add(1) == 0)
+        {
+          std::cerr << OPERATION_NAMES[operation] << ": " << e.what() << std::endl;
+        };
+      }
+
+      handles.release(handle);
+
+      if (run.measuring.load(std::memory_order_relaxed))
+      {
+        auto latency = std::chrono::steady_clock::now() - startTime;
+
+        run.latency[operation].record(latency);
+        run.all.record(latency);
+      };
+    };
+  }
+
+  /// @brief Formats a duration in microseconds.
+
+  std::string microseconds(std::chrono::nanoseconds duration)
+  {
+    char buffer[32];
+
+    std::snprintf(buffer, sizeof(buffer), "%10.1f", duration.count() / 1000.0);
+    return buffer;
+  }
+
+  /// @brief Prints one line of the results.
+
+  void printLine(std::string const &name, std::uint64_t count, double seconds, std::chrono::nanoseconds p50,
+                 std::chrono::nanoseconds p99, std::chrono::nanoseconds p999, std::chrono::nanoseconds max)
+  {
+    char buffer[64];
+
+    std::snprintf(buffer, sizeof(buffer), "  %-12s %10llu %12.1f", name.c_str(), static_cast<unsigned long long>(count),
+                  (seconds > 0) ? count / seconds : 0.0);
+    std::cout << buffer << microseconds(p50) << microseconds(p99) << microseconds(p999) << microseconds(max) << std::endl;
+  }
+
+  /// @brief Runs the mix with one thread count and pool size and prints the results.
+
+  void runLoad(options_t const &options, std::size_t threadCount, std::size_t poolSize)
+  {
+    CLoadConnector connector(static_cast<handle_t>(poolSize), options);
+    CHandleQueue handles(static_cast<handle_t>(poolSize));
+    run_t run;
+    std::vector<std::thread> threads;
+
+    connector.enableStatistics(true);
+
+    for (std::size_t index = 0; index < threadCount; ++index)
+    {
+      threads.emplace_back(loadThread, std::ref(connector), std::ref(handles), std::cref(options), std::ref(run),
+                           static_cast<unsigned int>(index + 1));
+    };
+
+      // The warm up opens the connections and fills the statement caches.
+
+    std::this_thread::sleep_for(options.warmup);
+    connector.resetStatistics();
+    run.measuring.store(true);
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(options.duration);
+    run.measuring.store(false);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    run.stop.store(true);
+    for (auto &thread : threads)
+    {
+      thread.join();
+    };
+
+    std::cout << "\nthreads " << threadCount << ", pool " << poolSize << ", errors " << run.errors.load() << "\n"
+              << "  operation         count        ops/s   p50 (us)   p99 (us)  p999 (us)   max (us)" << std::endl;
+
+    printLine("all", run.all.count(), seconds, run.all.percentile(0.5), run.all.percentile(0.99), run.all.percentile(0.999),
+              run.all.max());
+    for (std::size_t operation = 0; operation < OP_COUNT; ++operation)
+    {
+      CLatencyHistogram const &histogram = run.latency[operation];
+
+      if (histogram.count() != 0)
+      {
+        printLine(OPERATION_NAMES[operation], histogram.count(), seconds, histogram.percentile(0.5),
+                  histogram.percentile(0.99), histogram.percentile(0.999), histogram.max());
+      };
+    };
+
+    std::cout << "  phase" << std::endl;
+    for (std::size_t phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+      phaseStatistics_t statistics = connector.statistics(static_cast<latencyPhase_e>(phase));
+
+      if (statistics.count != 0)
+      {
+        printLine(PHASE_NAMES[phase], statistics.count, seconds, statistics.p50, statistics.p99, statistics.p999,
+                  statistics.max);
+      };
+    };
+  }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  options_t options;
+
+  try
+  {
+    for (int index = 1; index < argc; ++index)
+    {
+      std::string argument = argv[index];
+
+      if (index + 1 >= argc)
+      {
+        throw std::runtime_error("Missing value for " + argument);
+      };
+
+      std::string value = argv[++index];
+
+      if (argument == "--host")
+      {
+        options.host = value;
+      }
+      else if (argument == "--port")
+      {
+        options.port = std::stoul(value);
+      }
+      else if (argument == "--user")
+      {
+        options.user = value;
+      }
+      else if (argument == "--password")
+      {
+        options.password = value;
+      }
+      else if (argument == "--schema")
+      {
+        options.schema = value;
+      }
+      else if (argument == "--setup")
+      {
+        options.setupRows = std::stoul(value);
+        options.tableRows = options.setupRows;
+      }
+      else if (argument == "--rows")
+      {
+        options.tableRows = std::stoul(value);
+      }
+      else if (argument == "--threads")
+      {
+        options.threads = parseList(value);
+      }
+      else if (argument == "--pool")
+      {
+        options.poolSizes = parseList(value);
+      }
+      else if (argument == "--seconds")
+      {
+        options.duration = std::chrono::seconds(std::stoul(value));
+      }
+      else if (argument == "--warmup")
+      {
+        options.warmup = std::chrono::seconds(std::stoul(value));
+      }
+      else if (argument == "--mix")
+      {
+        options.mix = parseMix(value);
+      }
+      else
+      {
+        throw std::runtime_error("Unknown option " + argument);
+      };
+    };
+
+    if (options.tableRows == 0)
+    {
+      throw std::runtime_error("The table must have at least one row.");
+    };
+
+    if (options.setupRows != 0)
+    {
+      setupTables(options);
+    };
+
+    for (std::size_t poolSize : options.poolSizes)
+    {
+      for (std::size_t threadCount : options.threads)
+      {
+        runLoad(options, threadCount, poolSize);
+      };
+    };
+  }
+  catch(std::exception const &e)
+  {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,60 @@
+#-----------------------------------------------------------------------------------------------------------------------------------
+#
+# PROJECT:            Engineering Workshop Tracker (engineeringShop)
+# FILE:								loadGenerator.pro
+# SUBSYSTEM:          Project File - MariaDB connector load generator
+# LANGUAGE:						C++
+# TARGET OS:          LINUX
+# LIBRARY DEPENDANCE:	None.
+# NAMESPACE:          N/A
+# AUTHOR:							Gavin Blakeman.
+# LICENSE:            GPLv2
+#
+#                     Copyright 2026 Gavin Blakeman.
+#
+# OVERVIEW:						Project file for the load generator. The connector sources are compiled into the executable so that it
+#                     runs without the engineeringShop application.
+#
+# HISTORY:            2026-10-19/GGB - File Created
+#
+#-----------------------------------------------------------------------------------------------------------------------------------
+
+TARGET = loadGenerator
+
+TEMPLATE = app
+
+QT += core
+QT -= gui
+
+CONFIG += cmdline
+CONFIG -= app_bundle
+CONFIG += object_parallel_to_source
+
+QMAKE_CXXFLAGS += -std=c++20
+DEFINES += BOOST_THREAD_USE_LIB QT_GUI_LIB QT_CORE_LIB
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH +=  \
+    ".." \
+    "../../engineeringShop" \
+    "../../GCL" \
+    "../../MCL" \
+    "../../PCL" \
+    "../../SCL" \
+    "/usr/local/lib" \
+    "../../WtExtensions"
+
+SOURCES += \
+  loadGenerator.cpp \
+  ../source/database_mariadb.cpp \
+  ../source/exportSink.cpp \
+  ../source/latencyHistogram.cpp \
+  ../source/rowStore.cpp \
+  ../source/slowQueryLog.cpp \
+  ../source/temporalDecode.cpp \
+  ../source/workerPool.cpp
+
+LIBS += -L../../GCL -lGCL
+LIBS += -lmysqlclient
+LIBS += -lwt
+LIBS += -lpthread
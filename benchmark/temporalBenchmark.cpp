@@ -0,0 +1,100 @@
+﻿#include "include/temporalDecode.h"
+
+  // Standard C++ library
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+
+/* Temporal decode benchmark.
+ *
+ * Compares the fixed format decoders of temporalDecode.cpp with the Wt fromString() parsing they replaced, for DATE, TIME
+ * and DATETIME values in the formats returned by the server. Does not need a server.
+ *
+ * Usage:
+ *   temporalBenchmark [count]
+ */
+
+namespace
+{
+  using namespace database;
+
+  /// @brief Time per value of a decoder over the values, cycled until count values have been decoded.
+
+  template<typename Decode>
+  double timeDecode(std::vector<std::string> const &values, std::size_t count, std::size_t &valid, Decode decode)
+  {
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+      valid += decode(values[index % values.size()]);
+    };
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / count;
+  }
+
+  /// @brief Prints the comparison of one column type.
+
+  void printResult(char const *type, double fixedNanoseconds, double stringNanoseconds)
+  {
+    std::printf("%-10s %14.1f %14.1f %10.1fx\n", type, fixedNanoseconds, stringNanoseconds, stringNanoseconds / fixedNanoseconds);
+  }
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  try
+  {
+    std::size_t count = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+    std::vector<std::string> dates, times, dateTimes;
+
+      // Values vary so that the decode does not see the same value each time.
+
+    for (unsigned int id = 0; id < 1024; ++id)
+    {
+      char buffer[32];
+
+      std::snprintf(buffer, sizeof(buffer), "2024-%02u-%02u", 1 + id % 12, 1 + id % 28);
+      dates.emplace_back(buffer);
+      std::snprintf(buffer, sizeof(buffer), "%02u:%02u:%02u", id % 24, id % 60, (id / 60) % 60);
+      times.emplace_back(buffer);
+      dateTimes.emplace_back(dates.back() + " " + times.back());
+    };
+
+    std::size_t valid = 0;
+
+    std::printf("%zu values per type\n", count);
+    std::printf("%-10s %14s %14s %11s\n", "type", "fixed (ns)", "fromString (ns)", "speed up");
+
+    printResult("DATE",
+                timeDecode(dates, count, valid,
+                           [](std::string const &value) { return decodeDate(value.data(), value.size()).isValid(); }),
+                timeDecode(dates, count, valid,
+                           [](std::string const &value) { return Wt::WDate::fromString(value, "yyyy-MM-dd").isValid(); }));
+    printResult("TIME",
+                timeDecode(times, count, valid,
+                           [](std::string const &value) { return decodeTime(value.data(), value.size()).isValid(); }),
+                timeDecode(times, count, valid,
+                           [](std::string const &value) { return Wt::WTime::fromString(value, "hh:mm:ss").isValid(); }));
+    printResult("DATETIME",
+                timeDecode(dateTimes, count, valid,
+                           [](std::string const &value) { return decodeDateTime(value.data(), value.size()).isValid(); }),
+                timeDecode(dateTimes, count, valid, [](std::string const &value)
+                           { return Wt::WDateTime::fromString(value, "yyyy-MM-dd hh:mm:ss").isValid(); }));
+
+    std::printf("%zu valid\n", valid);
+  }
+  catch(std::exception const &e)
+  {
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
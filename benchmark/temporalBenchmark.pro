@@ -0,0 +1,42 @@
+#-----------------------------------------------------------------------------------------------------------------------------------
+#
+# PROJECT:            Engineering Workshop Tracker (engineeringShop)
+# FILE:								temporalBenchmark.pro
+# SUBSYSTEM:          Project File - MariaDB connector temporal decode benchmark
+# LANGUAGE:						C++
+# TARGET OS:          LINUX
+# LIBRARY DEPENDANCE:	None.
+# NAMESPACE:          N/A
+# AUTHOR:							Gavin Blakeman.
+# LICENSE:            GPLv2
+#
+#                     Copyright 2026 Gavin Blakeman.
+#
+# OVERVIEW:						Project file for the temporal decode benchmark.
+#
+# HISTORY:            2026-10-19/GGB - File Created
+#
+#-----------------------------------------------------------------------------------------------------------------------------------
+
+TARGET = temporalBenchmark
+
+TEMPLATE = app
+
+QT -= core gui
+
+CONFIG += cmdline
+CONFIG -= app_bundle
+CONFIG += object_parallel_to_source
+
+QMAKE_CXXFLAGS += -std=c++20 -O2
+
+INCLUDEPATH +=  \
+    ".." \
+    "../../engineeringShop" \
+    "../../GCL"
+
+SOURCES += \
+  temporalBenchmark.cpp \
+  ../source/temporalDecode.cpp
+
+LIBS += -lwt
@@ -3,7 +3,23 @@
 
   // Standard C++ libraries
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
   // Miscellaneous libraries
@@ -14,22 +30,174 @@
 
 #include "include/database/database//pluginDatabase.h"
 
+  // plugin_database_mariadb
+
+#include "include/exportSink.h"
+#include "include/latencyHistogram.h"
+#include "include/rowStore.h"
+#include "include/slowQueryLog.h"
+#include "include/typedRow.h"
+#include "include/workerPool.h"
+
 namespace database
 {
+  /// @brief Thrown when a query is cancelled because it passed its deadline. The connection handle remains usable.
+
+  class CQueryTimeout : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /// @brief The phases timed when statistics are enabled.
+
+  enum latencyPhase_e
+  {
+    PHASE_EXECUTE,        ///< Server call of processQuery() or processExec().
+    PHASE_FETCH,          ///< Retrieving a stored result.
+    PHASE_DECODE,         ///< processGetRecordSet()
+    PHASE_TRANSACTION,    ///< START TRANSACTION to COMMIT or ROLLBACK.
+    PHASE_COUNT
+  };
+
+  /// @brief Latency summary for one phase.
+
+  struct phaseStatistics_t
+  {
+    std::uint64_t count;
+    double ratePerSecond;             ///< count divided by the time since the statistics were enabled or reset.
+    std::chrono::nanoseconds p50;
+    std::chrono::nanoseconds p99;
+    std::chrono::nanoseconds p999;
+    std::chrono::nanoseconds max;
+  };
+
+  /* Threading
+   *
+   * The client library keeps per-thread state. Each thread is attached (mysql_thread_init) automatically the first time it
+   * uses the connector and detached (mysql_thread_end) when the thread exits. threadAttach() and threadDetach() are also
+   * provided through the plugin interface for thread pools that want to control this explicitly.
+   *
+   * A handle is owned by one thread at a time. Starting a transaction claims the handle for the calling thread until the
+   * transaction is committed or rolled back. Outside a transaction each statement claims the handle for the duration of the
+   * call. Any other thread using the handle while it is claimed gets a runtime error rather than corrupting the connection.
+   * The row cursor functions (moveFirst, moveNext, processGetRecord etc) are not checked and must be called by the thread
+   * that ran the query. There are no locks on the statement path; the claim is a single atomic compare-exchange.
+   */
+
   class CMariaDBConnector : public CConnectionPool
   {
   private:
-    struct connection_t
+    using variantType_t = decltype(std::declval<CVariant const &>().type());
+    using bindBool_t = std::remove_pointer_t<decltype(MYSQL_BIND::is_null)>;   // my_bool or bool, depending on the client library.
+
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+    static constexpr std::size_t STATEMENT_CACHE_SIZE = 64;   ///< Prepared statements retained per connection.
+    static constexpr std::size_t SHAPE_CACHE_SIZE = 1024;     ///< Statement shapes tracked per connection.
+    static constexpr std::uint32_t PREPARE_THRESHOLD = 3;     ///< Uses of a shape before it is executed as a prepared statement.
+    static constexpr std::size_t EXPLAIN_QUEUE_SIZE = 64;     ///< Slow statements waiting for EXPLAIN before more are dropped.
+    static constexpr std::chrono::milliseconds KILL_RETRY_DELAY{500}; ///< Wait before retrying a kill that could not be sent.
+    static constexpr std::size_t COALESCE_PACKET_MARGIN = 1024; ///< Room left below max_allowed_packet by coalesced statements.
+
+    /// @brief Usage of a parameterised statement shape. (The SQL with its placeholders)
+
+    struct shape_t
+    {
+      std::uint32_t useCount = 0;
+      bool resultKnown = false;           ///< The statement has been run once and it is known whether it returns rows.
+      bool returnsRows = false;
+      bool promotable = true;             ///< false if the server would not prepare the statement.
+    };
+
+    /// @brief Storage for one bound parameter. The MYSQL_BIND for the parameter points into this, so a new value is written
+    ///        in place and the bind array only has to be passed to the client library again if the type or buffer changes.
+
+    struct parameter_t
+    {
+      variantType_t type;
+      bool assigned = false;
+      union
+      {
+        std::uint8_t u8;
+        std::int8_t i8;
+        std::uint16_t u16;
+        std::int16_t i16;
+        std::uint32_t u32;
+        std::int32_t i32;
+        std::uint64_t u64;
+        std::int64_t i64;
+        float f;
+        double d;
+        MYSQL_TIME time;
+      } scalar;
+      std::string text;                   ///< STRING, DECIMAL and BLOB values. The capacity is retained between executions.
+      unsigned long length = 0;
+      bindBool_t isNull = 0;
+    };
+
+    /// @brief A prepared statement and its parameter bindings. Retained in the per-connection cache and reused each time the
+    ///        same SQL is prepared.
+
+    struct statement_t
+    {
+      std::string sql;
+      MYSQL_STMT *mysql_stmt = nullptr;
+      std::vector<MYSQL_BIND> bind;
+      std::vector<parameter_t> parameters;
+      bool bound = false;                 ///< The bind array has been passed to mysql_stmt_bind_param() and is unchanged.
+    };
+
+    struct bulkLoad_t;
+
+    /// @brief Per connection state that is not touched on every row: statement caches, buffers and the deadline shared with the
+    ///        watchdog. Allocated separately so the hot state of each handle stays compact.
+
+    struct alignas(CACHE_LINE_SIZE) connectionCold_t
+    {
+      std::vector<MYSQL_ROW_OFFSET> rowOffsets;   ///< Offset of each row in the stored result. Built on the first seek.
+      std::unordered_map<std::string, std::unique_ptr<statement_t>> statementCache;
+      std::vector<CVariant> outputParameters;
+      bulkLoad_t *bulkLoad = nullptr;     ///< The bulk load in progress. LOCAL INFILE requests are refused when nullptr.
+      std::unordered_map<std::string, shape_t> shapeCache;
+      std::string sqlBuffer;              ///< Reused for interpolated statements.
+      std::string valueBuffer;            ///< Reused for interpolated values.
+      std::vector<MYSQL_ROW> rowScratch;            ///< Reused by the parallel decode.
+      std::vector<unsigned long> lengthScratch;     ///< Reused by the parallel decode.
+      std::vector<char *> valueScratch;             ///< Reused by the parallel decode of a row store result.
+
+        // Results read under a memory budget.
+
+      std::size_t resultBudget = 0;                 ///< Bytes held in memory before the result spills. 0 for no limit.
+      std::unique_ptr<CRowStore> rowStore;
+      std::vector<char *> rowValues;                ///< The current row of a row store result.
+      std::vector<unsigned long> rowLengths;
+
+      std::chrono::steady_clock::time_point transactionStart;
+
+        // Query deadline. queryDeadline, deadlineGeneration and queryKilled are shared with the watchdog and guarded by
+        // deadlineMutex, so a kill in progress on one handle only delays that handle.
+
+      std::chrono::milliseconds queryTimeout{0};
+      std::mutex deadlineMutex;
+      std::chrono::steady_clock::time_point queryDeadline = std::chrono::steady_clock::time_point::max();
+      std::uint64_t deadlineGeneration = 0;         ///< Changed by each arm and disarm, so a stale kill is not sent.
+      bool queryKilled = false;
+    };
+
+    /// @brief Per connection state used on every query and row. Each entry is aligned to a cache line so that handles used by
+    ///        different threads never share a line.
+
+    struct alignas(CACHE_LINE_SIZE) connection_t
     {
       MYSQL *mysql;
       MYSQL_RES *mysql_res;
       MYSQL_FIELD *mysql_field;
       MYSQL_ROW mysql_row;
-      unsigned int columnCount;
       unsigned long *columnLengths;
       std::uint64_t rowCount;
       std::uint64_t rowCursorActual;    // Cursor posision in recordset
       std::uint64_t rowCursorRequested; // Cursor position in query
+      unsigned int columnCount;
       union
       {
         struct
@@ -38,18 +206,103 @@ namespace database
           int validRecord       : 1;
           int prepareStatement  : 1;
           int tip               : 1; ///< Transaction in process.
+          int rowStoreResult    : 1; ///< The rows of the result are in the row store, not the client library.
+          int transactionClaim  : 1; ///< The owner claim is held until the transaction is committed or rolled back.
         };
         std::uint64_t v;
       };
-      MYSQL_STMT *mysql_stmt;
-      std::string preparedStatement;
-      std::unique_ptr<MYSQL_BIND[]> mysql_bind;
-      std::vector<CVariant> inputParameters;
-      std::vector<CVariant> outputParameters;
+      statement_t *statement = nullptr;   ///< The statement being bound and executed.
+      std::size_t bindIndex = 0;          ///< The next input parameter to bind.
+      std::atomic<std::thread::id> owner; ///< The thread that has claimed the handle. Default id if not claimed.
+      std::unique_ptr<connectionCold_t> cold;
+    };
+
+    /// @brief Claims a handle for the calling thread for the life of the object. If the thread already owns the handle for an
+    ///        enclosing call the claim is left alone. If it owns it for a transaction, the claim is released once the
+    ///        transaction has ended.
 
+    class handleClaim_t
+    {
+    private:
+      connection_t &connection;
+      bool releases = false;    ///< This claim acquired the handle, or the handle was held by a transaction.
+
+    public:
+      handleClaim_t(CMariaDBConnector &, handle_t);
+      ~handleClaim_t();
+    };
+
+    /// @brief State shared with the LOCAL INFILE callbacks while a bulk load is streaming.
+
+    struct bulkLoad_t
+    {
+      std::function<bool(CRecord &)> rowProducer;
+      std::size_t columnCount;
+      CRecord record;
+      std::string buffer;               ///< Encoded rows not yet passed to the client library. Reused between rows.
+      std::size_t bufferPosition;
+      bool endOfData;
+      std::string errorText;
+    };
+
+    /// @brief A row waiting in a coalesced writer, and the promise completed when it has been written.
+
+    struct coalescedRow_t
+    {
+      std::vector<CVariant> values;
+      std::promise<void> done;
+    };
+
+    /// @brief A coalesced writer. Rows are queued by the calling threads and written by the flusher thread as multi-row
+    ///        INSERT statements on the writer's handle. pending and stop are guarded by mutex.
+
+    struct coalescedWriter_t
+    {
+      handle_t handle;
+      std::string prefix;                 ///< "INSERT INTO `table` (`column`, ...) VALUES "
+      std::size_t columnCount;
+      std::size_t maxRows;
+      std::size_t maxBytes;               ///< Limit on the statement length, below the server's max_allowed_packet.
+      bool transactional;                 ///< A failed statement writes none of its rows, so they can be retried singly.
+      std::chrono::microseconds window;
+      std::mutex mutex;
+      std::condition_variable condition;
+      std::vector<coalescedRow_t> pending;
+      bool stop = false;
+      std::thread thread;
     };
 
+    std::atomic<std::size_t> resultMemory{0};       ///< Memory held by the row stores. Must outlive connectionPool.
+    std::atomic<std::size_t> poolResultBudget{0};   ///< Limit on resultMemory. 0 for no limit.
+
     std::vector<connection_t> connectionPool;
+    std::uint64_t parallelDecodeThreshold = 4096;   ///< Smallest result that is decoded on more than one thread.
+    std::once_flag decodePoolCreated;
+    std::unique_ptr<CWorkerPool> decodePool;        ///< Shared by all the handles. Created by the first parallel decode.
+
+    std::mutex watchdogMutex;                       ///< Guards watchdogStop and watchdogRescan. Never held during I/O.
+    std::condition_variable watchdogCondition;
+    std::thread watchdogThread;
+    bool watchdogStop = false;
+    bool watchdogRescan = false;                    ///< A deadline earlier than watchdogWake has been armed.
+    std::atomic<std::chrono::steady_clock::rep> watchdogWake{INT64_MAX};   ///< When the watchdog will next scan. Ticks.
+    MYSQL *controlConnection = nullptr;             ///< Used by the watchdog thread only, to issue KILL QUERY.
+
+    std::atomic<std::int64_t> slowQueryThreshold{INT64_MAX};  ///< Nanoseconds. Maximum when the slow query log is disabled.
+    std::unique_ptr<CSlowQueryLog> slowQueryLog;
+    std::mutex explainMutex;                        ///< Guards slowQueryLog creation, explainQueue and explainStop.
+    std::condition_variable explainCondition;
+    std::deque<CSlowQueryLog::entry_t> explainQueue;  ///< Slow statements waiting for their EXPLAIN.
+    std::thread explainThread;
+    bool explainStop = false;
+    MYSQL *explainConnection = nullptr;             ///< Used by the explain thread only.
+
+    std::atomic<bool> statisticsEnabled{false};
+    std::atomic<std::chrono::steady_clock::rep> statisticsStart{0};
+    std::array<CLatencyHistogram, PHASE_COUNT> phaseLatency;
+
+    std::mutex coalesceMutex;                       ///< Guards coalescedWriters.
+    std::vector<std::unique_ptr<coalescedWriter_t>> coalescedWriters;
 
     virtual void processConnect() override {}   // not implemented. Connections are created as needed.
 
@@ -61,18 +314,55 @@ namespace database
     virtual bool processMoveFirst(handle_t) override;
     virtual bool processMoveNext(handle_t) override;
     virtual bool processMovePrevious(handle_t) override;
-    virtual bool processMoveLast(handle_t) override {};
+    virtual bool processMoveLast(handle_t) override;
     virtual void processGetRecord(handle_t, ::database::CRecord &) override;
     virtual void processGetRecordSet(handle_t, ::database::CRecordSet &) override;
     virtual bool processPrepareQuery(handle_t, std::string const &) override;
     virtual void processAddBindValue(handle_t, CVariant const &) override;
     virtual void processExec(handle_t) override;
 
+    void openConnection(handle_t);
     void processResults(handle_t);
+    void releaseResult(handle_t);
+    void storeRows(handle_t);
     void loadRow(handle_t);
+    void buildRowOffsets(handle_t);
     std::string processError(handle_t);
     ::database::CVariant processColumnValue(handle_t, std::size_t);
-    void createInputParameters(handle_t);
+    void decodeParallel(handle_t, ::database::CRecordSet &);
+    bool storeParameter(statement_t &, std::size_t, CVariant const &);
+    std::string processStatementError(handle_t);
+    void interpolateQuery(handle_t, std::string const &, std::vector<CVariant> const &);
+    void appendLiteral(handle_t, CVariant const &);
+    void armDeadline(handle_t);
+    bool disarmDeadline(handle_t);
+    void watchdog();
+    bool killQuery(handle_t, std::uint64_t);
+    void recordSlowQuery(handle_t, std::string const &, bool, std::chrono::steady_clock::time_point,
+                         std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point);
+    std::string explainQuery(std::string const &);
+    void explainer();
+    void coalesceFlusher(coalescedWriter_t &);
+    void coalesceFlush(coalescedWriter_t &, std::vector<coalescedRow_t> &);
+    std::size_t coalesceStatement(coalescedWriter_t &, coalescedRow_t *, std::size_t);
+    void coalesceExecute(coalescedWriter_t &);
+    void recordPhase(latencyPhase_e phase, std::chrono::steady_clock::duration duration)
+    {
+      if (statisticsEnabled.load(std::memory_order_relaxed))
+      {
+        phaseLatency[phase].record(duration);
+      };
+    }
+
+    static std::string quoteIdentifier(std::string const &);
+    static ::database::CVariant columnValue(MYSQL_FIELD const &, char const *, unsigned long);
+    static std::string_view variantBytes(CVariant const &);
+    static void variantText(CVariant const &, std::string &);
+    static void bulkLoadEncode(bulkLoad_t &);
+    static int localInfileInit(void **, char const *, void *);
+    static int localInfileRead(void *, char *, unsigned int);
+    static void localInfileEnd(void *);
+    static int localInfileError(void *, char *, unsigned int);
 
   protected:
   public:
@@ -80,11 +370,89 @@ namespace database
     virtual ~CMariaDBConnector();
 
     static CConnectionPool *createDatabaseConnector(handle_t, GCL::CReaderSections *cr);
+    static void threadAttach();
+    static void threadDetach();
+
+    void setParallelDecodeThreshold(std::uint64_t);
+    void setQueryTimeout(handle_t, std::chrono::milliseconds);
+    void setResultBudget(handle_t, std::size_t);
+    void setPoolResultBudget(std::size_t);
+
+    void parameterQuery(handle_t, std::string const &, std::vector<CVariant> const &);
+    std::uint64_t exportQuery(handle_t, std::string const &, CExportSink &, exportFormat_e);
+
+    template<typename Row>
+    std::vector<Row> typedQuery(handle_t, std::string const &);
+
+    void enableSlowQueryLog(std::chrono::microseconds, std::size_t = 256);
+    void disableSlowQueryLog();
+    std::vector<CSlowQueryLog::entry_t> slowQueries() const;
+
+    void enableStatistics(bool);
+    void resetStatistics();
+    phaseStatistics_t statistics(latencyPhase_e) const;
+
+    std::uint64_t bulkLoad(handle_t, std::string const &, std::vector<std::string> const &, CRecordSet const &);
+    std::uint64_t bulkLoad(handle_t, std::string const &, std::vector<std::string> const &, std::function<bool(CRecord &)>);
+
+    std::size_t enableCoalescedInsert(handle_t, std::string const &, std::vector<std::string> const &, std::size_t = 1000,
+                                      std::chrono::microseconds = std::chrono::microseconds(2000));
+    std::future<void> coalescedInsert(std::size_t, std::vector<CVariant>);
 
     friend class ::database::CRecord;
 
   };
 
+  /// @brief      Executes a query and decodes the rows directly into a vector of the row type. The decoder for each column is
+  ///             chosen at compile time from the row type and checked once against the result fields. See typedRow.h
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  query: The query to execute.
+  /// @returns    The rows.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  template<typename Row>
+  std::vector<Row> CMariaDBConnector::typedQuery(handle_t handle, std::string const &query)
+  {
+    constexpr auto columns = std::make_index_sequence<rowColumns<Row>::count>{};
+    handleClaim_t claim(*this, handle);
+
+    processQuery(handle, query);
+
+    connection_t &connection = connectionPool[handle];
+
+    if (connection.columnCount == 0)
+    {
+      RUNTIME_ERROR("Query did not return a result.");
+    };
+
+    checkRowFields<Row>(connection.mysql_field, connection.columnCount, columns);
+
+    std::vector<Row> returnValue(connection.rowCount);
+
+      // Walk the rows in order through loadRow() so that results in the row store are read the same way.
+
+    if (!connection.rowStoreResult)
+    {
+      mysql_data_seek(connection.mysql_res, 0);
+      connection.rowCursorActual = 0;
+    };
+
+    connection.rowCursorRequested = 0;
+    for (auto &row : returnValue)
+    {
+      loadRow(handle);
+      decodeRow(connection.mysql_row, connection.columnLengths, row, columns);
+      connection.rowCursorRequested++;
+    };
+
+      // The rows have been copied out, so the result and any row store memory are released.
+
+    releaseResult(handle);
+
+    return returnValue;
+  }
+
 } // namespace
 
 #endif // DATABASE_MARIADB_H
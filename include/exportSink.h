@@ -0,0 +1,67 @@
+﻿#ifndef EXPORTSINK_H
+#define EXPORTSINK_H
+
+  // Standard C++ libraries
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace database
+{
+  /* Formats written by CMariaDBConnector::exportQuery().
+   *
+   * EXPORT_CSV:    RFC 4180. A header line with the column names, CRLF line endings, fields quoted only when they contain a
+   *                comma, quote, CR or LF. NULL is written as an empty field.
+   * EXPORT_BINARY: "MDBX" followed by a format version byte, the column count and then, for each column, the field type and
+   *                name. Each row is then the column values, each as its length + 1 followed by the bytes. A length of 0
+   *                means NULL. All integers are unsigned LEB128 varints.
+   */
+
+  enum exportFormat_e
+  {
+    EXPORT_CSV,
+    EXPORT_BINARY,
+  };
+
+  /// @brief Destination for an export.
+
+  class CExportSink
+  {
+  public:
+    virtual ~CExportSink() = default;
+
+    virtual void write(char const *, std::size_t) = 0;
+    virtual void flush() = 0;
+  };
+
+  /// @brief Buffered export sink writing to a file. Large writes are combined with the buffered data in a single writev().
+  ///        With direct I/O the file is opened with O_DIRECT and only whole aligned blocks are written until the file is
+  ///        closed.
+
+  class CFileExportSink : public CExportSink
+  {
+  private:
+    static constexpr std::size_t BUFFER_SIZE = 1024 * 1024;
+    static constexpr std::size_t BLOCK_SIZE = 4096;     ///< Alignment required for O_DIRECT.
+
+    int fileDescriptor = -1;
+    bool directIO;
+    std::unique_ptr<char, void (*)(void *)> buffer;
+    std::size_t bufferUsed = 0;
+
+    void writeBuffer(std::size_t);
+
+  public:
+    CFileExportSink(std::string const &, bool = false);
+    virtual ~CFileExportSink();
+
+    virtual void write(char const *, std::size_t) override;
+    virtual void flush() override;
+    void close();
+  };
+
+} // namespace
+
+#endif // EXPORTSINK_H
@@ -0,0 +1,42 @@
+﻿#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+  // Standard C++ libraries
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace database
+{
+  /// @brief Lock free latency histogram. Values are counted in log-linear buckets (16 per power of two) so percentiles are
+  ///        accurate to about 6% over the whole range from nanoseconds to minutes. Recording is a single relaxed atomic
+  ///        increment, so it can be shared by all the threads using a connection pool.
+
+  class CLatencyHistogram
+  {
+  private:
+    static constexpr std::size_t SUB_BUCKET_BITS = 4;
+    static constexpr std::size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<std::uint64_t> maximum{0};
+
+    static std::size_t bucketIndex(std::uint64_t);
+    static std::uint64_t bucketValue(std::size_t);
+
+  public:
+    void record(std::chrono::nanoseconds);
+    void reset();
+
+    std::uint64_t count() const;
+    std::chrono::nanoseconds percentile(double) const;
+    std::chrono::nanoseconds max() const { return std::chrono::nanoseconds(maximum.load(std::memory_order_relaxed)); }
+  };
+
+} // namespace
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,78 @@
+﻿#ifndef ROWSTORE_H
+#define ROWSTORE_H
+
+  // Standard C++ libraries
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace database
+{
+  /* Row store for results read with a memory budget.
+   *
+   * Rows are appended as they are read from an unbuffered result. Each column is stored as its length + 1 as an unsigned
+   * LEB128 varint, 0 meaning NULL, followed by the bytes and a terminating NUL so the values can be used in place as a
+   * MYSQL_ROW. The rows are held in memory until the per result limit or the pool limit would be exceeded. The data is then
+   * moved to an unlinked temporary file that is mapped into memory and extended as further rows are appended, so every row
+   * can still be reached directly through the row index.
+   *
+   * The row index holds the offset of each row, 8 bytes per row. It is held in the same way as the data and counts against
+   * the same limits, and is moved to its own temporary file when the data is spilled.
+   */
+
+  class CRowStore
+  {
+  private:
+    /// @brief An area that grows as rows are appended. Held in memory until the store is spilled, then in a mapped
+    ///        temporary file.
+
+    struct area_t
+    {
+      std::unique_ptr<char[]> memory;
+      std::size_t memorySize = 0;
+      int fileDescriptor = -1;
+      char *map = nullptr;
+      std::size_t mapSize = 0;
+      std::size_t used = 0;
+
+      char *data() const noexcept { return map ? map : memory.get(); }
+    };
+
+    std::atomic<std::size_t> &poolMemory;   ///< Memory held by all the row stores of the pool.
+    std::size_t memoryLimit = SIZE_MAX;
+    std::size_t poolLimit = SIZE_MAX;
+
+    area_t rowData;
+    area_t rowOffsets;                      ///< The offset of each row in rowData.
+
+    void reserve(area_t &, std::size_t);
+    void spill(area_t &, std::size_t);
+    void spillArea(area_t &, std::size_t);
+    void growMap(area_t &, std::size_t);
+    void release(area_t &);
+
+  public:
+    CRowStore(std::atomic<std::size_t> &);
+    CRowStore(CRowStore const &) = delete;
+    CRowStore &operator=(CRowStore const &) = delete;
+    ~CRowStore();
+
+    void clear();
+    void reset(std::size_t, std::size_t);
+    void append(char const * const *, unsigned long const *, unsigned int);
+    void row(std::uint64_t, unsigned int, char **, unsigned long *) const;
+
+    /// @brief Returns the number of rows stored.
+
+    std::uint64_t rows() const noexcept { return rowOffsets.used / sizeof(std::uint64_t); }
+
+    /// @brief Returns true if the rows have been moved to the temporary file.
+
+    bool spilled() const noexcept { return rowData.map != nullptr; }
+  };
+
+} // namespace
+
+#endif // ROWSTORE_H
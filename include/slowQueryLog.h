@@ -0,0 +1,67 @@
+﻿#ifndef SLOWQUERYLOG_H
+#define SLOWQUERYLOG_H
+
+  // Standard C++ libraries
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace database
+{
+  /// @brief Fixed size ring buffer of slow statements. Writers take an index with a single atomic increment, claim the slot with
+  ///        a compare-exchange of its sequence number and publish it by making the sequence even again (seqlock), so recording
+  ///        never blocks and readers never block writers. When the buffer is full the oldest entries are overwritten.
+
+  class CSlowQueryLog
+  {
+  public:
+    struct entry_t
+    {
+      std::chrono::system_clock::time_point startTime;
+      std::chrono::nanoseconds executeTime;   ///< Time in the server call.
+      std::chrono::nanoseconds fetchTime;     ///< Time retrieving the result.
+      std::uint64_t rowCount;                 ///< Rows returned or affected.
+      std::string sql;
+      std::string parameterTypes;             ///< Comma separated types of the bound parameters.
+      std::string explain;                    ///< EXPLAIN output. Tab separated columns, one line per row.
+    };
+
+  private:
+    static constexpr std::size_t SQL_LENGTH = 1024;
+    static constexpr std::size_t PARAMETER_LENGTH = 256;
+    static constexpr std::size_t EXPLAIN_LENGTH = 2048;
+
+    struct slot_t
+    {
+      std::atomic<std::uint64_t> sequence{0};   ///< Odd while being written. 0 if never written.
+      std::chrono::system_clock::time_point startTime;
+      std::chrono::nanoseconds executeTime;
+      std::chrono::nanoseconds fetchTime;
+      std::uint64_t rowCount;
+      std::uint16_t sqlLength;
+      std::uint16_t parameterLength;
+      std::uint16_t explainLength;
+      char sql[SQL_LENGTH];
+      char parameterTypes[PARAMETER_LENGTH];
+      char explain[EXPLAIN_LENGTH];
+    };
+
+    std::unique_ptr<slot_t[]> slots;
+    std::size_t capacity;
+    std::atomic<std::uint64_t> writeIndex{0};
+
+  public:
+    CSlowQueryLog(std::size_t);
+
+    void record(entry_t const &);
+    std::vector<entry_t> entries() const;
+  };
+
+} // namespace
+
+#endif // SLOWQUERYLOG_H
@@ -0,0 +1,29 @@
+﻿#ifndef TEMPORALDECODE_H
+#define TEMPORALDECODE_H
+
+  // Standard C++ libraries
+
+#include <cstddef>
+#include <cstdint>
+
+  // Wt Library
+
+#include <Wt/WDateTime.h>
+
+namespace database
+{
+  /* Fixed format decoders for the temporal values returned by the server in the text protocol. The server always returns
+   * these values in one format, so the fields are read from fixed positions rather than parsing a format string.
+   *
+   * Zero dates ('0000-00-00') and zero date-times are returned as null values. TIME values that are not a time of day
+   * (negative, or 24 hours or more) cannot be held by Wt::WTime and throw.
+   */
+
+  Wt::WDate decodeDate(char const *, std::size_t);
+  Wt::WTime decodeTime(char const *, std::size_t);
+  Wt::WDateTime decodeDateTime(char const *, std::size_t);
+  std::uint16_t decodeYear(char const *, std::size_t);
+
+} // namespace
+
+#endif // TEMPORALDECODE_H
@@ -0,0 +1,284 @@
+﻿#ifndef TYPEDROW_H
+#define TYPEDROW_H
+
+  // Standard C++ libraries
+
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+  // Miscellaneous libraries
+
+#include "mysql/mysql.h"
+
+  // engineeringShop
+
+#include "include/database/database/pluginDatabase.h"
+
+  // plugin_database_mariadb
+
+#include "include/temporalDecode.h"
+
+namespace database
+{
+  /* Compile time row decoding for CMariaDBConnector::typedQuery().
+   *
+   * A row type is either a std::tuple, or a struct with a rowTraits specialisation listing its members in column order:
+   *
+   *   struct part_t { std::uint32_t partID; std::string description; std::optional<Wt::WDate> lastUsed; };
+   *
+   *   template<> struct database::rowTraits<part_t>
+   *   {
+   *     static constexpr auto members = std::make_tuple(&part_t::partID, &part_t::description, &part_t::lastUsed);
+   *   };
+   *
+   * Each member type needs a columnDecoder. accepts() is checked once per result against the field types; decode() converts
+   * the text value of the column. Members that are not std::optional may not be NULL.
+   */
+
+  template<typename T, typename = void>
+  struct columnDecoder;
+
+  template<typename T>
+  struct columnDecoder<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+  {
+    static bool accepts(MYSQL_FIELD const &field)
+    {
+      switch (field.type)
+      {
+        case MYSQL_TYPE_TINY:
+        case MYSQL_TYPE_SHORT:
+        case MYSQL_TYPE_LONG:
+        case MYSQL_TYPE_INT24:
+        case MYSQL_TYPE_LONGLONG:
+        case MYSQL_TYPE_YEAR:
+        {
+          return true;
+        }
+        default:
+        {
+          return false;
+        }
+      };
+    }
+
+    static void decode(char const *value, unsigned long length, T &member)
+    {
+      auto result = std::from_chars(value, value + length, member);
+
+      if ((result.ec != std::errc()) || (result.ptr != value + length))
+      {
+        RUNTIME_ERROR("Integer value out of range: " + std::string(value, length));
+      };
+    }
+  };
+
+  template<typename T>
+  struct columnDecoder<T, std::enable_if_t<std::is_floating_point_v<T>>>
+  {
+    static bool accepts(MYSQL_FIELD const &field)
+    {
+      return (field.type == MYSQL_TYPE_FLOAT) || (field.type == MYSQL_TYPE_DOUBLE) || (field.type == MYSQL_TYPE_DECIMAL) ||
+             (field.type == MYSQL_TYPE_NEWDECIMAL) || columnDecoder<long long>::accepts(field);
+    }
+
+    static void decode(char const *value, unsigned long length, T &member)
+    {
+      auto result = std::from_chars(value, value + length, member);
+
+      if (result.ec != std::errc())
+      {
+        RUNTIME_ERROR("Invalid floating point value: " + std::string(value, length));
+      };
+    }
+  };
+
+  template<>
+  struct columnDecoder<bool>
+  {
+    static bool accepts(MYSQL_FIELD const &field)
+    {
+      return (field.type == MYSQL_TYPE_TINY) || (field.type == MYSQL_TYPE_BIT);
+    }
+
+    static void decode(char const *value, unsigned long length, bool &member)
+    {
+        // BIT(1) is returned as a single byte of 0 or 1, TINYINT as text.
+
+      member = (length != 0) && (value[0] != '0') && (value[0] != '\0');
+    }
+  };
+
+  template<>
+  struct columnDecoder<std::string>
+  {
+    static bool accepts(MYSQL_FIELD const &)
+    {
+      return true;
+    }
+
+    static void decode(char const *value, unsigned long length, std::string &member)
+    {
+      member.assign(value, length);
+    }
+  };
+
+  template<>
+  struct columnDecoder<Wt::WDate>
+  {
+    static bool accepts(MYSQL_FIELD const &field)
+    {
+      return (field.type == MYSQL_TYPE_DATE) || (field.type == MYSQL_TYPE_NEWDATE);
+    }
+
+    static void decode(char const *value, unsigned long length, Wt::WDate &member)
+    {
+      member = decodeDate(value, length);
+    }
+  };
+
+  template<>
+  struct columnDecoder<Wt::WTime>
+  {
+    static bool accepts(MYSQL_FIELD const &field)
+    {
+      return (field.type == MYSQL_TYPE_TIME) || (field.type == MYSQL_TYPE_TIME2);
+    }
+
+    static void decode(char const *value, unsigned long length, Wt::WTime &member)
+    {
+      member = decodeTime(value, length);
+    }
+  };
+
+  template<>
+  struct columnDecoder<Wt::WDateTime>
+  {
+    static bool accepts(MYSQL_FIELD const &field)
+    {
+      return (field.type == MYSQL_TYPE_DATETIME) || (field.type == MYSQL_TYPE_DATETIME2) ||
+             (field.type == MYSQL_TYPE_TIMESTAMP) || (field.type == MYSQL_TYPE_TIMESTAMP2);
+    }
+
+    static void decode(char const *value, unsigned long length, Wt::WDateTime &member)
+    {
+      member = decodeDateTime(value, length);
+    }
+  };
+
+  template<typename T>
+  struct columnDecoder<std::optional<T>>
+  {
+    static bool accepts(MYSQL_FIELD const &field)
+    {
+      return columnDecoder<T>::accepts(field);
+    }
+
+    static void decode(char const *value, unsigned long length, std::optional<T> &member)
+    {
+      columnDecoder<T>::decode(value, length, member.emplace());
+    }
+  };
+
+  /// @brief Specialise for struct row types. See above.
+
+  template<typename Row>
+  struct rowTraits;
+
+  template<typename T>
+  struct isOptional : std::false_type {};
+
+  template<typename T>
+  struct isOptional<std::optional<T>> : std::true_type {};
+
+  /// @brief Access to the columns of a row type, by column index.
+
+  template<typename Row>
+  struct rowColumns
+  {
+    static constexpr std::size_t count = std::tuple_size_v<std::decay_t<decltype(rowTraits<Row>::members)>>;
+
+    template<std::size_t I>
+    static auto &get(Row &row)
+    {
+      return row.*std::get<I>(rowTraits<Row>::members);
+    }
+  };
+
+  template<typename... Ts>
+  struct rowColumns<std::tuple<Ts...>>
+  {
+    static constexpr std::size_t count = sizeof...(Ts);
+
+    template<std::size_t I>
+    static auto &get(std::tuple<Ts...> &row)
+    {
+      return std::get<I>(row);
+    }
+  };
+
+  template<typename Row, std::size_t I>
+  using columnType_t = std::remove_reference_t<decltype(rowColumns<Row>::template get<I>(std::declval<Row &>()))>;
+
+  /// @brief Checks the fields of a result against the row type. Called once per result.
+  /// @throws std::runtime_error
+
+  template<typename Row, std::size_t... I>
+  void checkRowFields(MYSQL_FIELD const *fields, unsigned int fieldCount, std::index_sequence<I...>)
+  {
+    if (fieldCount != rowColumns<Row>::count)
+    {
+      RUNTIME_ERROR("Result has " + std::to_string(fieldCount) + " columns, row type has " +
+                    std::to_string(rowColumns<Row>::count) + ".");
+    };
+
+    std::size_t column = 0;
+    bool accepted = true;
+
+    ((accepted = accepted && columnDecoder<columnType_t<Row, I>>::accepts(fields[column = I])), ...);
+
+    if (!accepted)
+    {
+      RUNTIME_ERROR("Column " + std::string(fields[column].name, fields[column].name_length) +
+                    " cannot be decoded into the row type.");
+    };
+  }
+
+  /// @brief Decodes one column into the row.
+  /// @throws std::runtime_error
+
+  template<typename Row, std::size_t I>
+  void decodeRowColumn(char const *value, unsigned long length, Row &row)
+  {
+    auto &member = rowColumns<Row>::template get<I>(row);
+
+    if (value)
+    {
+      columnDecoder<columnType_t<Row, I>>::decode(value, length, member);
+    }
+    else if constexpr (isOptional<columnType_t<Row, I>>::value)
+    {
+      member.reset();
+    }
+    else
+    {
+      RUNTIME_ERROR("NULL value in column " + std::to_string(I) + ", which is not optional in the row type.");
+    };
+  }
+
+  /// @brief Decodes a row of the result into the row type.
+  /// @throws std::runtime_error
+
+  template<typename Row, std::size_t... I>
+  void decodeRow(MYSQL_ROW mysql_row, unsigned long const *lengths, Row &row, std::index_sequence<I...>)
+  {
+    (decodeRowColumn<Row, I>(mysql_row[I], lengths[I], row), ...);
+  }
+
+} // namespace
+
+#endif // TYPEDROW_H
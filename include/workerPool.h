@@ -0,0 +1,58 @@
+﻿#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+  // Standard C++ libraries
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace database
+{
+  /// @brief Fixed size pool of worker threads shared by all the handles of a connector. A caller submits a job of a number of
+  ///        independent tasks and takes part in running them, so the number of threads decoding at any time is bounded by the
+  ///        pool size plus the calling threads, however many sessions are busy. Tasks must not throw.
+
+  class CWorkerPool
+  {
+  private:
+    struct job_t
+    {
+      std::function<void(std::size_t)> const &task;
+      std::size_t taskCount;
+      std::atomic<std::size_t> nextTask{0};
+      std::size_t completed = 0;            ///< Guarded by mutex.
+      std::condition_variable finished;
+
+      job_t(std::function<void(std::size_t)> const &t, std::size_t c) : task(t), taskCount(c) {}
+    };
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<job_t *> jobs;
+    std::vector<std::thread> threads;
+    bool stop = false;
+
+    void worker();
+
+  public:
+    CWorkerPool(std::size_t);
+    CWorkerPool(CWorkerPool const &) = delete;
+    CWorkerPool &operator=(CWorkerPool const &) = delete;
+    ~CWorkerPool();
+
+    void run(std::size_t, std::function<void(std::size_t)> const &);
+
+    /// @brief Returns the number of worker threads.
+
+    std::size_t size() const noexcept { return threads.size(); }
+  };
+
+} // namespace
+
+#endif // WORKERPOOL_H
@@ -60,11 +60,24 @@ INCLUDEPATH +=  \
 
 SOURCES += \
   source/database_mariadb.cpp \
-  source/plugin_database_mariadb.cpp
+  source/exportSink.cpp \
+  source/latencyHistogram.cpp \
+  source/plugin_database_mariadb.cpp \
+  source/rowStore.cpp \
+  source/slowQueryLog.cpp \
+  source/temporalDecode.cpp \
+  source/workerPool.cpp
 
 
 HEADERS += \
-  include/database_mariadb.h
+  include/database_mariadb.h \
+  include/exportSink.h \
+  include/latencyHistogram.h \
+  include/rowStore.h \
+  include/slowQueryLog.h \
+  include/temporalDecode.h \
+  include/typedRow.h \
+  include/workerPool.h
 
 LIBS += -L../GCL -lGCL
 LIBS += -lmysqlclient
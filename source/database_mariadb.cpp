@@ -1,15 +1,117 @@
 ﻿#include "include/database_mariadb.h"
 
+  // Standard C++ library
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <thread>
+
   // engineeringShop
 
 #include "include/database/database/record.h"
 #include "include/database/database/databaseVariant.h"
 
+  // plugin_database_mariadb
+
+#include "include/temporalDecode.h"
+
 //#define DEBUG_ON
 #undef DEBUG_ON
 
 namespace database
 {
+  namespace
+  {
+    /// @brief Calls mysql_thread_end() when a thread that has been attached exits.
+
+    struct threadState_t
+    {
+      bool attached = false;
+
+      ~threadState_t()
+      {
+        if (attached)
+        {
+          mysql_thread_end();
+        };
+      }
+    };
+
+    thread_local threadState_t threadState;
+  }
+
+  /// @brief      Attaches the calling thread to the client library. Called automatically the first time a thread uses the
+  ///             connector, so only needed by thread pools that want to attach their workers up front.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::threadAttach()
+  {
+    if (!threadState.attached)
+    {
+      if (mysql_thread_init())
+      {
+        RUNTIME_ERROR("Unable to initialise client library thread state.");
+      };
+      threadState.attached = true;
+    };
+  }
+
+  /// @brief      Detaches the calling thread from the client library. Called automatically when an attached thread exits. Must
+  ///             not be called while the thread still has a handle claimed.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::threadDetach()
+  {
+    if (threadState.attached)
+    {
+      mysql_thread_end();
+      threadState.attached = false;
+    };
+  }
+
+  /// @brief      Claims the handle for the calling thread. Attaches the thread to the client library if needed.
+  /// @param[in]  connector: The connector owning the handle.
+  /// @param[in]  handle: The connection pool handle.
+  /// @throws     std::runtime_error if another thread has claimed the handle.
+  /// @version    2026-10-19/GGB - Function created.
+
+  CMariaDBConnector::handleClaim_t::handleClaim_t(CMariaDBConnector &connector, handle_t handle)
+    : connection(connector.connectionPool[handle])
+  {
+    threadAttach();
+
+    std::thread::id expected;
+    std::thread::id self = std::this_thread::get_id();
+
+    if (connection.owner.compare_exchange_strong(expected, self, std::memory_order_acquire))
+    {
+      releases = true;
+    }
+    else if (expected == self)
+    {
+      releases = connection.transactionClaim;
+    }
+    else
+    {
+      RUNTIME_ERROR("Handle " + std::to_string(handle) + " in use by another thread.");
+    };
+  }
+
+  /// @brief      Releases the claim, unless the handle is now held by a transaction. The transaction keeps the claim until it
+  ///             is committed or rolled back, and the claim that ends it releases the handle.
+  /// @version    2026-10-19/GGB - Function created.
+
+  CMariaDBConnector::handleClaim_t::~handleClaim_t()
+  {
+    if (releases && !connection.transactionClaim)
+    {
+      connection.owner.store(std::thread::id(), std::memory_order_release);
+    };
+  }
 
   /// @brief Constructor for the connectors.
   /// @param[in] poolSize: The size of the connection pool.
@@ -23,6 +125,20 @@ namespace database
       connectionPool[i].mysql_res = nullptr;
       connectionPool[i].mysql_field = nullptr;
       connectionPool[i].v = 0;
+      connectionPool[i].cold = std::make_unique<connectionCold_t>();
+
+        // Needed for bulkLoad(). The handler is installed permanently so that the client library's file reading handler is
+        // never used. Requests are refused unless bulkLoad() is running on the connection, so neither a LOAD DATA LOCAL
+        // INFILE passed to processQuery() nor a hostile server can read files from this host.
+
+      unsigned int localInfile = 1;
+      mysql_options(connectionPool[i].mysql, MYSQL_OPT_LOCAL_INFILE, &localInfile);
+      mysql_set_local_infile_handler(connectionPool[i].mysql,
+                                     &CMariaDBConnector::localInfileInit,
+                                     &CMariaDBConnector::localInfileRead,
+                                     &CMariaDBConnector::localInfileEnd,
+                                     &CMariaDBConnector::localInfileError,
+                                     connectionPool[i].cold.get());
     }
   }
 
@@ -31,8 +147,60 @@ namespace database
 
   CMariaDBConnector::~CMariaDBConnector()
   {
+      // Stop the coalesced writers first. Each flushes the rows already queued before it exits.
+
+    for (auto &writer : coalescedWriters)
+    {
+      {
+        std::lock_guard<std::mutex> lock(writer->mutex);
+        writer->stop = true;
+      }
+      writer->condition.notify_one();
+      writer->thread.join();
+    };
+    coalescedWriters.clear();
+
+    if (watchdogThread.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(watchdogMutex);
+        watchdogStop = true;
+      }
+      watchdogCondition.notify_one();
+      watchdogThread.join();
+    };
+
+    if (controlConnection)
+    {
+      mysql_close(controlConnection);
+      controlConnection = nullptr;
+    };
+
+    if (explainThread.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(explainMutex);
+        explainStop = true;
+      }
+      explainCondition.notify_one();
+      explainThread.join();
+    };
+
+    if (explainConnection)
+    {
+      mysql_close(explainConnection);
+      explainConnection = nullptr;
+    };
+
     for (auto &connection :  connectionPool)
     {
+      for (auto &statement : connection.cold->statementCache)
+      {
+        mysql_stmt_close(statement.second->mysql_stmt);
+      };
+      connection.cold->statementCache.clear();
+      connection.statement = nullptr;
+
       mysql_close(connection.mysql);
       connection.mysql = nullptr;
       connection.mysql_res = nullptr;
@@ -40,278 +208,1553 @@ namespace database
     }
   }
 
-  /// @brief Create and populate the struct for the bind parameters before calling the prepared statement.
-  /// @param[in] handle: The connection pool handle.
+  /// @brief      Appends a value to the statement being interpolated as an SQL literal. Strings and temporal values are escaped
+  ///             with mysql_real_escape_string() using the connection character set. BLOBs are written as hexadecimal literals.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  value: The value to append.
   /// @throws
-  /// @version 2022-10-25/GGB - Function created.
+  /// @version    2026-10-19/GGB - Function created.
 
-
-  void CMariaDBConnector::createInputParameters(handle_t handle)
+  void CMariaDBConnector::appendLiteral(handle_t handle, CVariant const &value)
   {
-    connectionPool[handle].mysql_bind = std::make_unique<MYSQL_BIND[]>(connectionPool[handle].inputParameters.size());
+    std::string &sqlBuffer = connectionPool[handle].cold->sqlBuffer;
+    std::string &valueBuffer = connectionPool[handle].cold->valueBuffer;
 
-    std::size_t index = 0;
-    for (auto &bv: connectionPool[handle].inputParameters)
+    switch (value.type())
     {
-      enum_field_types fieldType;
-
-      switch(bv.type())
+      case NULLVALUE:
       {
-        case BIT:
-        {
-          fieldType = MYSQL_TYPE_BIT;
+        sqlBuffer += "NULL";
+        break;
+      }
+      case STRING:
+      case DATE:
+      case TIME:
+      case DATETIME:
+      {
+        valueBuffer.clear();
+        variantText(value, valueBuffer);
 
-          break;
-        }
-        case BLOB:
-        {
-          fieldType = MYSQL_TYPE_BLOB;
-          connectionPool[handle].mysql_bind[index].buffer = 0;
-          break;
-        }
-        case U8:
+        std::size_t start = sqlBuffer.size();
+
+        sqlBuffer.resize(start + 2 * valueBuffer.size() + 3);
+        sqlBuffer[start] = '\'';
+
+        unsigned long length = mysql_real_escape_string(connectionPool[handle].mysql, &sqlBuffer[start + 1], valueBuffer.data(),
+                                                        valueBuffer.size());
+        if (length == static_cast<unsigned long>(-1))
         {
-          fieldType = MYSQL_TYPE_TINY;
-          connectionPool[handle].mysql_bind[index].is_unsigned = true;
-          break;
+          RUNTIME_ERROR(processError(handle));
         };
-        case I8:
+
+        sqlBuffer.resize(start + 1 + length);
+        sqlBuffer += '\'';
+        break;
+      }
+      case BLOB:
+      {
+        static char const hexDigits[] = "0123456789ABCDEF";
+
+        valueBuffer.clear();
+        variantText(value, valueBuffer);
+
+        sqlBuffer += "X'";
+        for (unsigned char c : valueBuffer)
         {
-          fieldType = MYSQL_TYPE_TINY;
-          connectionPool[handle].mysql_bind[index].buffer_length = sizeof(std::int8_t);
-          break;
+          sqlBuffer += hexDigits[c >> 4];
+          sqlBuffer += hexDigits[c & 0x0F];
         };
-        case U16:
-        {
-          fieldType = MYSQL_TYPE_SHORT;
-          connectionPool[handle].mysql_bind[index].is_unsigned = true;
-          connectionPool[handle].mysql_bind[index].buffer_length = sizeof(std::uint16_t);
-          break;
-        }
-        case I16:
-        {
-          fieldType = MYSQL_TYPE_SHORT;
-          connectionPool[handle].mysql_bind[index].buffer_length = sizeof(std::int16_t);
-          break;
-        }
-        case U32:
-        {
-          fieldType = MYSQL_TYPE_LONG;
-          connectionPool[handle].mysql_bind[index].is_unsigned = true;
-          connectionPool[handle].mysql_bind[index].buffer_length = sizeof(std::uint32_t);
-          break;
-        }
-        case I32:
-        {
-          fieldType = MYSQL_TYPE_LONG;
-          connectionPool[handle].mysql_bind[index].buffer_length = sizeof(std::int32_t);
-          break;
-        }
-        case U64:
-        {
-          fieldType = MYSQL_TYPE_LONGLONG;
-          connectionPool[handle].mysql_bind[index].is_unsigned = true;
-          break;
-        }
-        case I64:
-        {
-          fieldType = MYSQL_TYPE_LONGLONG;
-          break;
-        }
-        case FLOAT:
-        {
-          fieldType = MYSQL_TYPE_FLOAT;
-          break;
-        }
-        case DOUBLE:
-        {
-          fieldType = MYSQL_TYPE_DOUBLE;
-          break;
-        }
-        case STRING:
-        {
-          fieldType = MYSQL_TYPE_VAR_STRING;
-          break;
-        }
-        case NULLVALUE:
-        {
-          fieldType = MYSQL_TYPE_NULL;
-          break;
-        }
-        case BOOL:
-        {
-          fieldType = MYSQL_TYPE_BOOL;
-          break;
-        }
-        case DATE:
-        {
-          fieldType = MYSQL_TYPE_DATE;
-          break;
-        }
-        case TIME:
-        {
-          fieldType = MYSQL_TYPE_TIME;
-          break;
-        }
-        case DATETIME:
-        {
-          fieldType = MYSQL_TYPE_DATETIME;
-          break;
-        }
-        case DECIMAL:
-        {
-          fieldType = MYSQL_TYPE_DECIMAL;
-          break;
-        }
-        default:
-        {
-          CODE_ERROR();
-        }
-      };
+        sqlBuffer += '\'';
+        break;
+      }
+      default:
+      {
+          // Numbers, DECIMAL, BOOL and BIT are written as numeric literals.
 
-      connectionPool[handle].mysql_bind[index].buffer_type = fieldType;
-      connectionPool[handle].mysql_bind[index].buffer = static_cast<void *>(bv);
-      connectionPool[handle].mysql_bind[index].buffer_length = bv.bufferLength();
-    }
+        variantText(value, sqlBuffer);
+        break;
+      }
+    };
   }
 
-  /// @brief Factory function.
-  /// @param[in] poolSize: The size of the pool.
-  /// @param[in] cr: Configuration reader.
-  /// @throws
-  /// @version 2022-09-27/GGB - Function created.
+  /// @brief      Enables or disables the latency statistics. Enabling does not clear the values already recorded.
+  /// @param[in]  enable: true to record statistics.
+  /// @version    2026-10-19/GGB - Function created.
 
-  CConnectionPool *CMariaDBConnector::createDatabaseConnector(database::handle_t poolSize, GCL::CReaderSections *cr)
+  void CMariaDBConnector::enableStatistics(bool enable)
   {
-    return new CMariaDBConnector(poolSize);
+    if (enable && !statisticsEnabled.load())
+    {
+      statisticsStart.store(std::chrono::steady_clock::now().time_since_epoch().count());
+    };
+    statisticsEnabled.store(enable);
   }
 
-  /// @brief Loads the row data for the current row.
-  /// @param[in] handle: The handle to load.
-  /// @throws
-  /// @version 2022-09-20/GGB - Function created.
+  /// @brief      Starts the deadline for the query about to be sent on the handle. The watchdog is only woken if it would
+  ///             otherwise sleep past this deadline, which with equal timeouts is only when it has nothing else to wait for.
+  /// @param[in]  handle: The connection pool handle.
+  /// @version    2026-10-19/GGB - Function created.
 
-  void CMariaDBConnector::loadRow(handle_t handle)
+  void CMariaDBConnector::armDeadline(handle_t handle)
   {
-    if (connectionPool[handle].rowCursorActual != connectionPool[handle].rowCursorRequested)
+    connectionCold_t &cold = *connectionPool[handle].cold;
+    auto deadline = std::chrono::steady_clock::now() + cold.queryTimeout;
+
     {
-      mysql_data_seek(connectionPool[handle].mysql_res, connectionPool[handle].rowCursorRequested);
-      connectionPool[handle].rowCursorActual = connectionPool[handle].rowCursorRequested;
-    };
+      std::lock_guard<std::mutex> lock(cold.deadlineMutex);
 
-    connectionPool[handle].mysql_row = mysql_fetch_row(connectionPool[handle].mysql_res);
-    connectionPool[handle].rowCursorActual++;       // mysql_fetch_row moves to next row.
-    connectionPool[handle].columnLengths = mysql_fetch_lengths(connectionPool[handle].mysql_res);
+      cold.queryDeadline = deadline;
+      cold.queryKilled = false;
+      ++cold.deadlineGeneration;
+    }
 
-    connectionPool[handle].validRecord = true;
+    if (deadline.time_since_epoch().count() < watchdogWake.load())
+    {
+      {
+        std::lock_guard<std::mutex> lock(watchdogMutex);
+        watchdogRescan = true;
+      }
+      watchdogCondition.notify_one();
+    };
   }
 
-  /// @brief Adds a positional binding value.
-  /// @param[in] handle: The connection handle in use.
-  /// @param[in] v: The value to bind.
-  /// @param[in] pt: The type of parameter.
+  /// @brief      Bulk loads the records in a recordset into a table using LOAD DATA LOCAL INFILE. The data is streamed from memory
+  ///             and never written to disk.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  tableName: The table to load into.
+  /// @param[in]  columnNames: The columns to load. The values in each record must be in the same order.
+  /// @param[in]  recordSet: The records to load.
+  /// @returns    The number of rows loaded.
   /// @throws
-  /// @version 2022-10-20/GGB - Function created.
+  /// @version    2026-10-19/GGB - Function created.
 
-  void CMariaDBConnector::processAddBindValue(handle_t handle, CVariant const &bindValue)
+  std::uint64_t CMariaDBConnector::bulkLoad(handle_t handle, std::string const &tableName,
+                                            std::vector<std::string> const &columnNames, CRecordSet const &recordSet)
   {
-    if ( (bindValue.paramType() == PT_IN) || (bindValue.paramType() == PT_INOUT) )
-    {
-      connectionPool[handle].inputParameters.push_back(bindValue);
-    };
+    std::size_t recordIndex = 0;
 
-    if ( (bindValue.paramType() == PT_OUT) || (bindValue.paramType() == PT_INOUT) )
+    return bulkLoad(handle, tableName, columnNames, [&recordSet, &recordIndex](CRecord &record) -> bool
     {
-      connectionPool[handle].outputParameters.push_back(bindValue);
-    }
+      if (recordIndex < recordSet.size())
+      {
+        record = recordSet[recordIndex++];
+        return true;
+      }
+      else
+      {
+        return false;
+      }
+    });
   }
 
-
-  /// @brief      Begins a transaction. Starts by opening the connection if required and then sending a "START TRANSACTION" to the
-  ///             server.
-  /// @param[in]  handle: The connection handle to use.
+  /// @brief      Bulk loads rows into a table using LOAD DATA LOCAL INFILE. Rows are requested from the producer as the client
+  ///             library needs them and are encoded incrementally into a reused buffer.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  tableName: The table to load into.
+  /// @param[in]  columnNames: The columns to load. The values in each record must be in the same order.
+  /// @param[in]  rowProducer: Called to fill the next record. Returns false when there are no more rows.
+  /// @returns    The number of rows loaded.
   /// @throws
-  /// @version    2022-09-28/GGB - Function created.
+  /// @version    2026-10-19/GGB - Function created.
 
-  void CMariaDBConnector::processBeginTransaction(handle_t handle)
+  std::uint64_t CMariaDBConnector::bulkLoad(handle_t handle, std::string const &tableName,
+                                            std::vector<std::string> const &columnNames,
+                                            std::function<bool(CRecord &)> rowProducer)
   {
-    std::string const STARTTRANSACTION = "START TRANSACTION";
+    handleClaim_t claim(*this, handle);
 
-      // Create the 'real' connection if not already created.
+    std::string query = "LOAD DATA LOCAL INFILE 'bulkLoad' INTO TABLE " + quoteIdentifier(tableName) +
+                        " CHARACTER SET utf8mb4 FIELDS TERMINATED BY '\\t' ESCAPED BY '\\\\' LINES TERMINATED BY '\\n' (";
 
-    if (!connectionPool[handle].connectedFlag)
+    for (std::size_t index = 0; index < columnNames.size(); ++index)
     {
-      if (mysql_real_connect(connectionPool[handle].mysql,
-                             host_.c_str(),
-                             user_.c_str(),
-                             passwd_.c_str(),
-                             schema_.c_str(),
-                             port_,
-                             "",
-                             0))
+      if (index != 0)
       {
-        connectionPool[handle].connectedFlag = true;
+        query += ", ";
+      };
+      query += quoteIdentifier(columnNames[index]);
+    };
+    query += ")";
+
+    openConnection(handle);
+
+    bulkLoad_t bulkLoadData;
+    bulkLoadData.rowProducer = std::move(rowProducer);
+    bulkLoadData.columnCount = columnNames.size();
+    bulkLoadData.bufferPosition = 0;
+    bulkLoadData.endOfData = false;
+
+    connectionPool[handle].cold->bulkLoad = &bulkLoadData;
+
+    DEBUGMESSAGE(query);
+
+    int errorCode = mysql_real_query(connectionPool[handle].mysql, query.c_str(), query.length());
+
+    connectionPool[handle].cold->bulkLoad = nullptr;
+
+    if (errorCode)
+    {
+      if (!bulkLoadData.errorText.empty())
+      {
+        RUNTIME_ERROR(bulkLoadData.errorText);
       }
       else
       {
-          // Unable to connect.
-
         RUNTIME_ERROR(processError(handle));
-      }
-    }
+      };
+    };
 
-    DEBUGMESSAGE(STARTTRANSACTION);
+    return mysql_affected_rows(connectionPool[handle].mysql);
+  }
 
-    if (!mysql_real_query(connectionPool[handle].mysql, STARTTRANSACTION.c_str(), STARTTRANSACTION.length()))
+  /// @brief      Requests the next row from the producer and appends it to the buffer in LOAD DATA format. (Tab separated,
+  ///             backslash escaped, NULL as \N)
+  /// @param[in]  bulkLoadData: The bulk load state.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::bulkLoadEncode(bulkLoad_t &bulkLoadData)
+  {
+    if (!bulkLoadData.rowProducer(bulkLoadData.record))
     {
-      connectionPool[handle].tip = true;
+      bulkLoadData.endOfData = true;
     }
     else
     {
-        // Error.
+      std::string &buffer = bulkLoadData.buffer;
 
-      RUNTIME_ERROR(processError(handle));
-    }
+      for (std::size_t columnIndex = 0; columnIndex < bulkLoadData.columnCount; ++columnIndex)
+      {
+        if (columnIndex != 0)
+        {
+          buffer += '\t';
+        };
+
+        CVariant const &value = bulkLoadData.record[columnIndex];
+
+        if (value.type() == NULLVALUE)
+        {
+          buffer += "\\N";
+        }
+        else
+        {
+            // Encode the value directly into the buffer and then escape the appended text in place.
+
+          std::size_t start = buffer.size();
+          variantText(value, buffer);
+
+          std::size_t escapes = 0;
+          for (std::size_t index = start; index < buffer.size(); ++index)
+          {
+            char c = buffer[index];
+            escapes += (c == '\\' || c == '\t' || c == '\n' || c == '\r' || c == '\0');
+          };
+
+          if (escapes != 0)
+          {
+            std::size_t source = buffer.size();
+            buffer.resize(buffer.size() + escapes);
+            std::size_t destination = buffer.size();
+
+            while (source > start)
+            {
+              char c = buffer[--source];
+
+              switch (c)
+              {
+                case '\\': buffer[--destination] = '\\'; break;
+                case '\t': buffer[--destination] = 't'; break;
+                case '\n': buffer[--destination] = 'n'; break;
+                case '\r': buffer[--destination] = 'r'; break;
+                case '\0': buffer[--destination] = '0'; break;
+                default:
+                {
+                  buffer[--destination] = c;
+                  continue;
+                }
+              };
+              buffer[--destination] = '\\';
+            };
+          };
+        };
+      };
+
+      buffer += '\n';
+    };
   }
 
-  /// @brief      Commits the current transaction.
-  /// @param[in]  handle: The connection handle
-  /// @throws
-  /// @version    2022-09-28/GGB - Function created.
+  /// @brief      Queues a row on a coalesced writer. The row is written with other rows queued in the same window and the
+  ///             returned future becomes ready when the statement containing it has been executed.
+  /// @param[in]  writer: The writer returned by enableCoalescedInsert().
+  /// @param[in]  values: The column values, in the order given when the writer was enabled.
+  /// @returns    A future that is ready when the row has been written, or holds the exception if it could not be written.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
 
-  void CMariaDBConnector::processCommitTransaction(handle_t handle)
+  std::future<void> CMariaDBConnector::coalescedInsert(std::size_t writer, std::vector<CVariant> values)
   {
-    std::string const COMMITTRANSACTION = "COMMIT";
+    coalescedWriter_t *coalescedWriter;
 
-    if (mysql_real_query(connectionPool[handle].mysql, COMMITTRANSACTION.c_str(), COMMITTRANSACTION.length()))
     {
-      RUNTIME_ERROR(processError(handle));
+      std::lock_guard<std::mutex> lock(coalesceMutex);
+
+      if (writer >= coalescedWriters.size())
+      {
+        RUNTIME_ERROR("Invalid coalesced writer: " + std::to_string(writer));
+      };
+      coalescedWriter = coalescedWriters[writer].get();
     }
 
-    if (connectionPool[handle].mysql_res)
+    if (values.size() != coalescedWriter->columnCount)
     {
-      mysql_free_result(connectionPool[handle].mysql_res);
-      connectionPool[handle].mysql_res = nullptr;
-      connectionPool[handle].tip = false;
+      RUNTIME_ERROR("Coalesced insert has " + std::to_string(values.size()) + " values, expected " +
+                    std::to_string(coalescedWriter->columnCount) + ".");
     };
 
-    DEBUGMESSAGE("COMMIT TRANSACTION");
+    std::future<void> returnValue;
+    bool notify;
+
+    {
+      std::lock_guard<std::mutex> lock(coalescedWriter->mutex);
+
+      coalescedWriter->pending.push_back(coalescedRow_t{std::move(values), std::promise<void>()});
+      returnValue = coalescedWriter->pending.back().done.get_future();
+
+        // The flusher only needs waking to start the window, or to end it early when the batch is full.
+
+      notify = (coalescedWriter->pending.size() == 1) || (coalescedWriter->pending.size() >= coalescedWriter->maxRows);
+    }
+
+    if (notify)
+    {
+      coalescedWriter->condition.notify_one();
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Builds a multi-row INSERT in the handle's sqlBuffer from the first rows given. The statement holds at most
+  ///             maxRows rows and stops before the row that would take it past maxBytes. The first row is always included, so
+  ///             a row too long for the server fails on its own.
+  /// @param[in]  writer: The coalesced writer.
+  /// @param[in]  rows: The first row to write.
+  /// @param[in]  count: The number of rows available.
+  /// @returns    The number of rows in the statement.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::size_t CMariaDBConnector::coalesceStatement(coalescedWriter_t &writer, coalescedRow_t *rows, std::size_t count)
+  {
+    handle_t handle = writer.handle;
+    std::size_t returnValue = 0;
+
+    openConnection(handle);
+
+    std::string &sqlBuffer = connectionPool[handle].cold->sqlBuffer;
+
+    sqlBuffer = writer.prefix;
+    while ((returnValue < count) && (returnValue < writer.maxRows))
+    {
+      std::size_t rowStart = sqlBuffer.size();
+
+      sqlBuffer += (returnValue == 0) ? "(" : ", (";
+      for (std::size_t columnIndex = 0; columnIndex < writer.columnCount; ++columnIndex)
+      {
+        if (columnIndex != 0)
+        {
+          sqlBuffer += ", ";
+        };
+        appendLiteral(handle, rows[returnValue].values[columnIndex]);
+      };
+      sqlBuffer += ')';
+
+      if ((sqlBuffer.size() > writer.maxBytes) && (returnValue != 0))
+      {
+        sqlBuffer.resize(rowStart);       // The row starts the next statement.
+        break;
+      };
+
+      ++returnValue;
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Executes the statement built by coalesceStatement() on the writer's handle.
+  /// @param[in]  writer: The coalesced writer.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::coalesceExecute(coalescedWriter_t &writer)
+  {
+    handle_t handle = writer.handle;
+    std::string &sqlBuffer = connectionPool[handle].cold->sqlBuffer;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (mysql_real_query(connectionPool[handle].mysql, sqlBuffer.data(), sqlBuffer.size()))
+    {
+      RUNTIME_ERROR(processError(handle));
+    };
+
+    recordPhase(PHASE_EXECUTE, std::chrono::steady_clock::now() - startTime);
+  }
+
+  /// @brief      Writes a batch taken from the pending queue and completes the promise of each row. The batch is written in
+  ///             statements limited by maxRows and maxBytes.
+  ///             If a statement fails on a transactional table none of its rows were written, so they are retried one at a
+  ///             time and a single bad row only fails its own caller. On a non-transactional table (Aria, MyISAM) the rows
+  ///             before the failing one may already have been written, and a retry would duplicate them, so every row of the
+  ///             statement fails with the statement's error.
+  /// @param[in]  writer: The coalesced writer.
+  /// @param[in]  batch: The rows to write.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::coalesceFlush(coalescedWriter_t &writer, std::vector<coalescedRow_t> &batch)
+  {
+    std::size_t first = 0;
+
+    while (first < batch.size())
+    {
+      std::size_t count = 1;        // If the statement cannot be built, only its first row fails.
+
+      try
+      {
+        handleClaim_t claim(*this, writer.handle);
+
+        count = coalesceStatement(writer, &batch[first], batch.size() - first);
+        coalesceExecute(writer);
+
+        for (std::size_t index = first; index < first + count; ++index)
+        {
+          batch[index].done.set_value();
+        };
+      }
+      catch(...)
+      {
+        if ((count == 1) || !writer.transactional)
+        {
+          for (std::size_t index = first; index < first + count; ++index)
+          {
+            batch[index].done.set_exception(std::current_exception());
+          };
+        }
+        else
+        {
+          for (std::size_t index = first; index < first + count; ++index)
+          {
+            try
+            {
+              handleClaim_t claim(*this, writer.handle);
+
+              coalesceStatement(writer, &batch[index], 1);
+              coalesceExecute(writer);
+              batch[index].done.set_value();
+            }
+            catch(...)
+            {
+              batch[index].done.set_exception(std::current_exception());
+            }
+          };
+        };
+      }
+
+      first += count;
+    };
+  }
+
+  /// @brief      The flusher thread of a coalesced writer. Waits for the first row, then for the window to elapse or the batch
+  ///             to fill, and writes everything queued. Rows still queued when the writer is stopped are written before the
+  ///             thread exits.
+  /// @param[in]  writer: The coalesced writer.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::coalesceFlusher(coalescedWriter_t &writer)
+  {
+    threadAttach();
+
+    std::vector<coalescedRow_t> batch;
+    std::unique_lock<std::mutex> lock(writer.mutex);
+
+    for (;;)
+    {
+      writer.condition.wait(lock, [&writer] { return writer.stop || !writer.pending.empty(); });
+
+      if (writer.pending.empty())
+      {
+        break;
+      };
+
+      writer.condition.wait_for(lock, writer.window,
+                                [&writer] { return writer.stop || (writer.pending.size() >= writer.maxRows); });
+
+      batch.swap(writer.pending);
+      lock.unlock();
+
+      coalesceFlush(writer, batch);
+      batch.clear();
+
+      lock.lock();
+    };
+  }
+
+  /// @brief      Decodes all the rows of the stored result into the recordSet on the connector's worker pool. The rows are
+  ///             already in memory, so the row pointers are collected first and each task decodes a contiguous range of rows
+  ///             into the pre-sized recordSet.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[out] recordSet: The recordSet to fill. Must already be sized to the number of rows.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::decodeParallel(handle_t handle, ::database::CRecordSet &recordSet)
+  {
+    std::uint64_t const rowCount = connectionPool[handle].rowCount;
+    std::size_t const columnCount = connectionPool[handle].columnCount;
+    MYSQL_FIELD const *fields = connectionPool[handle].mysql_field;
+
+      // The lengths are only available for the current row, so they are copied as the rows are walked. The scratch vectors
+      // are retained by the connection so that repeated large results do not reallocate.
+
+    std::vector<MYSQL_ROW> &rows = connectionPool[handle].cold->rowScratch;
+    std::vector<unsigned long> &lengths = connectionPool[handle].cold->lengthScratch;
+
+    rows.resize(rowCount);
+    lengths.resize(rowCount * columnCount);
+
+    if (connectionPool[handle].rowStoreResult)
+    {
+      std::vector<char *> &values = connectionPool[handle].cold->valueScratch;
+
+      values.resize(rowCount * columnCount);
+      for (std::uint64_t rowIndex = 0; rowIndex < rowCount; ++rowIndex)
+      {
+        rows[rowIndex] = &values[rowIndex * columnCount];
+        connectionPool[handle].cold->rowStore->row(rowIndex, columnCount, rows[rowIndex], &lengths[rowIndex * columnCount]);
+      };
+    }
+    else
+    {
+      connectionPool[handle].cold->rowOffsets.resize(rowCount);
+      mysql_data_seek(connectionPool[handle].mysql_res, 0);
+
+      for (std::uint64_t rowIndex = 0; rowIndex < rowCount; ++rowIndex)
+      {
+        connectionPool[handle].cold->rowOffsets[rowIndex] = mysql_row_tell(connectionPool[handle].mysql_res);
+        rows[rowIndex] = mysql_fetch_row(connectionPool[handle].mysql_res);
+        unsigned long *rowLengths = mysql_fetch_lengths(connectionPool[handle].mysql_res);
+        std::copy(rowLengths, rowLengths + columnCount, lengths.begin() + rowIndex * columnCount);
+      };
+    };
+    connectionPool[handle].rowCursorActual = rowCount;
+
+      // The rows are split into ranges of half the threshold. There are usually more ranges than workers, so the ranges of a
+      // result are shared out between whichever workers are free.
+
+    std::call_once(decodePoolCreated, [this]
+    {
+      decodePool = std::make_unique<CWorkerPool>(std::max(std::thread::hardware_concurrency(), 2U) - 1);
+    });
+
+    std::uint64_t const rangeSize = parallelDecodeThreshold / 2;
+    std::size_t const rangeCount = (rowCount + rangeSize - 1) / rangeSize;
+    std::vector<std::exception_ptr> exceptions(rangeCount);
+
+    std::function<void(std::size_t)> decodeRows = [&](std::size_t rangeIndex)
+    {
+      try
+      {
+        std::uint64_t const first = rangeIndex * rangeSize;
+        std::uint64_t const last = std::min(first + rangeSize, rowCount);
+
+        for (std::uint64_t rowIndex = first; rowIndex < last; ++rowIndex)
+        {
+          ::database::CRecord &record = recordSet[rowIndex];
+          unsigned long const *rowLengths = &lengths[rowIndex * columnCount];
+
+          record.clear();
+          for (std::size_t columnIndex = 0; columnIndex < columnCount; ++columnIndex)
+          {
+            record.setValue(columnIndex, columnValue(fields[columnIndex], rows[rowIndex][columnIndex], rowLengths[columnIndex]));
+          };
+        };
+      }
+      catch(...)
+      {
+        exceptions[rangeIndex] = std::current_exception();
+      }
+    };
+
+    decodePool->run(rangeCount, decodeRows);      // The calling thread decodes ranges as well.
+
+    for (auto &exception : exceptions)
+    {
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      };
+    };
+
+      // Leave the cursor on the last row, as the serial path does.
+
+    connectionPool[handle].rowCursorRequested = rowCount - 1;
+    loadRow(handle);
+  }
+
+  /// @brief Factory function.
+  /// @param[in] poolSize: The size of the pool.
+  /// @param[in] cr: Configuration reader.
+  /// @throws
+  /// @version 2022-09-27/GGB - Function created.
+
+  CConnectionPool *CMariaDBConnector::createDatabaseConnector(database::handle_t poolSize, GCL::CReaderSections *cr)
+  {
+    return new CMariaDBConnector(poolSize);
+  }
+
+  /// @brief      Builds the index of row offsets for the stored result. The rows are walked once; after that any row can be
+  ///             reached with mysql_row_seek() in constant time. Only needed when the cursor does not move sequentially.
+  /// @param[in]  handle: The connection pool handle.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::buildRowOffsets(handle_t handle)
+  {
+    MYSQL_RES *mysql_res = connectionPool[handle].mysql_res;
+
+    connectionPool[handle].cold->rowOffsets.resize(connectionPool[handle].rowCount);
+
+    mysql_data_seek(mysql_res, 0);
+    for (auto &rowOffset : connectionPool[handle].cold->rowOffsets)
+    {
+      rowOffset = mysql_row_tell(mysql_res);
+      mysql_fetch_row(mysql_res);
+    };
+
+    connectionPool[handle].rowCursorActual = connectionPool[handle].rowCount;
+  }
+
+  /// @brief Loads the row data for the current row.
+  /// @param[in] handle: The handle to load.
+  /// @throws
+  /// @version 2022-09-20/GGB - Function created.
+  /// @version 2026-10-19/GGB - Use the row offset index rather than mysql_data_seek() so that seeks are constant time.
+
+  void CMariaDBConnector::loadRow(handle_t handle)
+  {
+    if (connectionPool[handle].rowStoreResult)
+    {
+        // Rows in the row store are reached directly by index.
+
+      connectionCold_t &cold = *connectionPool[handle].cold;
+
+      cold.rowStore->row(connectionPool[handle].rowCursorRequested, connectionPool[handle].columnCount, cold.rowValues.data(),
+                         cold.rowLengths.data());
+      connectionPool[handle].mysql_row = cold.rowValues.data();
+      connectionPool[handle].columnLengths = cold.rowLengths.data();
+      connectionPool[handle].rowCursorActual = connectionPool[handle].rowCursorRequested + 1;
+      connectionPool[handle].validRecord = true;
+      return;
+    };
+
+    if (connectionPool[handle].rowCursorRequested == 0)
+    {
+        // Returning to the first row does not need the index, so forward only cursors never build it.
+
+      if (connectionPool[handle].rowCursorActual != 0)
+      {
+        mysql_data_seek(connectionPool[handle].mysql_res, 0);
+        connectionPool[handle].rowCursorActual = 0;
+      };
+    }
+    else if (connectionPool[handle].rowCursorActual != connectionPool[handle].rowCursorRequested)
+    {
+      if (connectionPool[handle].cold->rowOffsets.empty())
+      {
+        buildRowOffsets(handle);
+      };
+
+      mysql_row_seek(connectionPool[handle].mysql_res,
+                     connectionPool[handle].cold->rowOffsets[connectionPool[handle].rowCursorRequested]);
+      connectionPool[handle].rowCursorActual = connectionPool[handle].rowCursorRequested;
+    };
+
+    connectionPool[handle].mysql_row = mysql_fetch_row(connectionPool[handle].mysql_res);
+    connectionPool[handle].rowCursorActual++;       // mysql_fetch_row moves to next row.
+    connectionPool[handle].columnLengths = mysql_fetch_lengths(connectionPool[handle].mysql_res);
+
+    connectionPool[handle].validRecord = true;
+  }
+
+  /// @brief      Builds the statement in the connection's sqlBuffer, replacing each ? placeholder with the matching parameter as
+  ///             an SQL literal. Placeholders inside quoted strings, quoted identifiers and comments are left alone.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  sql: The statement with the placeholders.
+  /// @param[in]  parameters: The parameter values.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::interpolateQuery(handle_t handle, std::string const &sql, std::vector<CVariant> const &parameters)
+  {
+    std::string &sqlBuffer = connectionPool[handle].cold->sqlBuffer;
+    std::size_t parameterIndex = 0;
+    std::size_t index = 0;
+
+    sqlBuffer.clear();
+
+    while (index < sql.size())
+    {
+      char c = sql[index];
+
+      if ((c == '\'') || (c == '"') || (c == '`'))
+      {
+          // Copy the quoted text up to and including the closing quote.
+
+        std::size_t end = index + 1;
+
+        while ((end < sql.size()) && (sql[end] != c))
+        {
+          end += ((sql[end] == '\\') && (c != '`')) ? 2 : 1;
+        };
+        end = std::min(end + 1, sql.size());
+        sqlBuffer.append(sql, index, end - index);
+        index = end;
+      }
+      else if ((c == '#') || ((c == '-') && (sql.compare(index, 3, "-- ") == 0)))
+      {
+        std::size_t end = std::min(sql.find('\n', index), sql.size());
+        sqlBuffer.append(sql, index, end - index);
+        index = end;
+      }
+      else if ((c == '/') && (sql.compare(index, 2, "/*") == 0))
+      {
+        std::size_t end = sql.find("*/", index + 2);
+        end = (end == std::string::npos) ? sql.size() : end + 2;
+        sqlBuffer.append(sql, index, end - index);
+        index = end;
+      }
+      else if (c == '?')
+      {
+        if (parameterIndex >= parameters.size())
+        {
+          RUNTIME_ERROR("More placeholders than parameters.");
+        };
+        appendLiteral(handle, parameters[parameterIndex++]);
+        ++index;
+      }
+      else
+      {
+        sqlBuffer += c;
+        ++index;
+      };
+    };
+
+    if (parameterIndex != parameters.size())
+    {
+      RUNTIME_ERROR("More parameters than placeholders.");
+    };
+  }
+
+  /// @brief      Kills the query running on a handle using KILL QUERY from the control connection. The connection itself is not
+  ///             killed and can be used for the next query. Called by the watchdog thread with no locks held. The control
+  ///             connection is opened before the handle is locked; the kill is only sent if the deadline has not been re-armed
+  ///             or disarmed since it expired.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  generation: The deadline generation that expired.
+  /// @returns    false if the kill could not be sent and is still needed.
+  /// @version    2026-10-19/GGB - Function created.
+
+  bool CMariaDBConnector::killQuery(handle_t handle, std::uint64_t generation)
+  {
+    if (!controlConnection)
+    {
+      unsigned int const timeout = 5;
+
+      controlConnection = mysql_init(nullptr);
+      mysql_options(controlConnection, MYSQL_OPT_CONNECT_TIMEOUT, &timeout);
+      mysql_options(controlConnection, MYSQL_OPT_READ_TIMEOUT, &timeout);
+      mysql_options(controlConnection, MYSQL_OPT_WRITE_TIMEOUT, &timeout);
+
+      if (!mysql_real_connect(controlConnection, host_.c_str(), user_.c_str(), passwd_.c_str(), schema_.c_str(), port_, "", 0))
+      {
+        DEBUGMESSAGE("Unable to open control connection: " + std::string(mysql_error(controlConnection)));
+        mysql_close(controlConnection);
+        controlConnection = nullptr;
+        return false;
+      };
+    };
+
+    connectionCold_t &cold = *connectionPool[handle].cold;
+    std::lock_guard<std::mutex> lock(cold.deadlineMutex);
+
+    if (cold.deadlineGeneration != generation)
+    {
+      return true;                                  // The query finished while the control connection was opened.
+    };
+
+    std::string query = "KILL QUERY " + std::to_string(mysql_thread_id(connectionPool[handle].mysql));
+
+    DEBUGMESSAGE(query);
+
+    if (mysql_real_query(controlConnection, query.c_str(), query.length()))
+    {
+      DEBUGMESSAGE("Unable to kill query: " + std::string(mysql_error(controlConnection)));
+
+        // The control connection may have been lost. Reopen it on the next kill.
+
+      mysql_close(controlConnection);
+      controlConnection = nullptr;
+      return false;
+    };
+
+    cold.queryKilled = true;
+    return true;
+  }
+
+  /// @brief      Executes a query and streams the result to a sink without materialising it. The result is read unbuffered with
+  ///             mysql_use_result() and each value is written straight from the row buffer of the client library, so memory
+  ///             use does not depend on the size of the result.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  query: The query to execute.
+  /// @param[in]  sink: The destination for the data.
+  /// @param[in]  format: The format to write. See exportSink.h
+  /// @returns    The number of rows written.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::uint64_t CMariaDBConnector::exportQuery(handle_t handle, std::string const &query, CExportSink &sink,
+                                               exportFormat_e format)
+  {
+    handleClaim_t claim(*this, handle);
+
+    std::uint64_t returnValue = 0;
+
+    auto writeVarint = [&sink](std::uint64_t value)
+    {
+      char bytes[10];
+      std::size_t count = 0;
+
+      do
+      {
+        bytes[count] = static_cast<char>(value & 0x7F);
+        value >>= 7;
+        bytes[count++] |= (value != 0) ? 0x80 : 0;
+      }
+      while (value != 0);
+
+      sink.write(bytes, count);
+    };
+
+    auto writeCSV = [&sink](char const *value, std::size_t length)
+    {
+      bool quote = false;
+
+      for (std::size_t index = 0; (index < length) && !quote; ++index)
+      {
+        quote = (value[index] == ',') || (value[index] == '"') || (value[index] == '\r') || (value[index] == '\n');
+      };
+
+      if (!quote)
+      {
+        sink.write(value, length);
+      }
+      else
+      {
+          // Write up to and including each quote, then the quote again.
+
+        sink.write("\"", 1);
+        char const *end = value + length;
+        while (char const *next = static_cast<char const *>(std::memchr(value, '"', end - value)))
+        {
+          sink.write(value, next - value + 1);
+          sink.write("\"", 1);
+          value = next + 1;
+        };
+        sink.write(value, end - value);
+        sink.write("\"", 1);
+      };
+    };
+
+    openConnection(handle);
+
+    DEBUGMESSAGE(query);
+
+    if (mysql_real_query(connectionPool[handle].mysql, query.c_str(), query.length()))
+    {
+      RUNTIME_ERROR(processError(handle));
+    };
+
+    MYSQL_RES *mysql_res = mysql_use_result(connectionPool[handle].mysql);
+
+    if (!mysql_res)
+    {
+      RUNTIME_ERROR("Unable to retrieve query results.");
+    };
+
+    try
+    {
+      unsigned int columnCount = mysql_num_fields(mysql_res);
+      MYSQL_FIELD *fields = mysql_fetch_fields(mysql_res);
+
+      if (format == EXPORT_CSV)
+      {
+        for (unsigned int columnIndex = 0; columnIndex < columnCount; ++columnIndex)
+        {
+          if (columnIndex != 0)
+          {
+            sink.write(",", 1);
+          };
+          writeCSV(fields[columnIndex].name, fields[columnIndex].name_length);
+        };
+        sink.write("\r\n", 2);
+      }
+      else
+      {
+        sink.write("MDBX\x01", 5);
+        writeVarint(columnCount);
+        for (unsigned int columnIndex = 0; columnIndex < columnCount; ++columnIndex)
+        {
+          writeVarint(fields[columnIndex].type);
+          writeVarint(fields[columnIndex].name_length);
+          sink.write(fields[columnIndex].name, fields[columnIndex].name_length);
+        };
+      };
+
+      while (MYSQL_ROW mysql_row = mysql_fetch_row(mysql_res))
+      {
+        unsigned long *lengths = mysql_fetch_lengths(mysql_res);
+
+        for (unsigned int columnIndex = 0; columnIndex < columnCount; ++columnIndex)
+        {
+          if (format == EXPORT_CSV)
+          {
+            if (columnIndex != 0)
+            {
+              sink.write(",", 1);
+            };
+            if (mysql_row[columnIndex])
+            {
+              writeCSV(mysql_row[columnIndex], lengths[columnIndex]);
+            };
+          }
+          else if (mysql_row[columnIndex])
+          {
+            writeVarint(static_cast<std::uint64_t>(lengths[columnIndex]) + 1);
+            sink.write(mysql_row[columnIndex], lengths[columnIndex]);
+          }
+          else
+          {
+            writeVarint(0);
+          };
+        };
+
+        if (format == EXPORT_CSV)
+        {
+          sink.write("\r\n", 2);
+        };
+        ++returnValue;
+      };
+
+        // mysql_fetch_row() also returns nullptr if the connection fails part way through.
+
+      if (mysql_errno(connectionPool[handle].mysql))
+      {
+        RUNTIME_ERROR(processError(handle));
+      };
+
+      sink.flush();
+    }
+    catch(...)
+    {
+      mysql_free_result(mysql_res);     // Reads and discards any remaining rows so the connection can be reused.
+      throw;
+    }
+
+    mysql_free_result(mysql_res);
+
+    return returnValue;
+  }
+
+  /// @brief      Local infile callback. Called by the client library when the server requests the file. Only the request
+  ///             made by bulkLoad() is accepted.
+  /// @param[out] ptr: Receives the bulk load state, or nullptr if the request is refused.
+  /// @param[in]  fileName: The file requested.
+  /// @param[in]  userdata: The cold state of the connection, passed to mysql_set_local_infile_handler.
+  /// @returns    0 on success.
+  /// @version    2026-10-19/GGB - Function created.
+
+  int CMariaDBConnector::localInfileInit(void **ptr, char const *fileName, void *userdata)
+  {
+    bulkLoad_t *bulkLoadData = static_cast<connectionCold_t *>(userdata)->bulkLoad;
+
+    if (!bulkLoadData || !fileName || (std::strcmp(fileName, "bulkLoad") != 0))
+    {
+      *ptr = nullptr;
+      return 1;
+    };
+
+    *ptr = bulkLoadData;
+    return 0;
+  }
+
+  /// @brief      Local infile callback. Supplies the next block of encoded rows.
+  /// @param[in]  ptr: The bulk load state.
+  /// @param[out] buf: The buffer to fill.
+  /// @param[in]  bufLen: The size of the buffer.
+  /// @returns    The number of bytes written, 0 at the end of the data, or -1 on error.
+  /// @version    2026-10-19/GGB - Function created.
+
+  int CMariaDBConnector::localInfileRead(void *ptr, char *buf, unsigned int bufLen)
+  {
+    bulkLoad_t &bulkLoadData = *static_cast<bulkLoad_t *>(ptr);
+
+    try
+    {
+        // Drop the consumed data. The capacity is retained so the buffer is only grown, never reallocated per row.
+
+      if (bulkLoadData.bufferPosition != 0)
+      {
+        bulkLoadData.buffer.erase(0, bulkLoadData.bufferPosition);
+        bulkLoadData.bufferPosition = 0;
+      };
+
+      while (!bulkLoadData.endOfData && bulkLoadData.buffer.size() < bufLen)
+      {
+        bulkLoadEncode(bulkLoadData);
+      };
+
+      std::size_t bytes = std::min<std::size_t>(bufLen, bulkLoadData.buffer.size());
+      std::memcpy(buf, bulkLoadData.buffer.data(), bytes);
+      bulkLoadData.bufferPosition = bytes;
+
+      return static_cast<int>(bytes);
+    }
+    catch(std::exception const &e)
+    {
+      bulkLoadData.errorText = e.what();
+      return -1;
+    }
+    catch(...)
+    {
+        // Nothing may unwind through the client library's callback.
+
+      bulkLoadData.errorText = "Bulk load row producer failed with an unknown exception.";
+      return -1;
+    }
+  }
+
+  /// @brief      Local infile callback. Called when the transfer completes. The state is owned by bulkLoad().
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::localInfileEnd(void *)
+  {
+  }
+
+  /// @brief      Local infile callback. Returns the error from the row producer, or the reason the request was refused.
+  /// @param[in]  ptr: The bulk load state. nullptr if the request was refused.
+  /// @param[out] errorMessage: Buffer for the error message.
+  /// @param[in]  errorMessageLength: Length of the error message buffer.
+  /// @returns    The error code.
+  /// @version    2026-10-19/GGB - Function created.
+
+  int CMariaDBConnector::localInfileError(void *ptr, char *errorMessage, unsigned int errorMessageLength)
+  {
+    static std::string const REFUSED = "LOAD DATA LOCAL INFILE refused. Only bulkLoad() may send local data.";
+
+    std::string const &errorText = ptr ? static_cast<bulkLoad_t *>(ptr)->errorText : REFUSED;
+
+    if (errorMessageLength != 0)
+    {
+      std::size_t length = std::min<std::size_t>(errorMessageLength - 1, errorText.size());
+      std::memcpy(errorMessage, errorText.data(), length);
+      errorMessage[length] = '\0';
+    };
+
+    return 2000;    // CR_UNKNOWN_ERROR
+  }
+
+  /// @brief      Opens the connection to the server if it is not already open.
+  /// @param[in]  handle: The connection handle to use.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::openConnection(handle_t handle)
+  {
+    if (!connectionPool[handle].connectedFlag)
+    {
+      if (mysql_real_connect(connectionPool[handle].mysql,
+                             host_.c_str(),
+                             user_.c_str(),
+                             passwd_.c_str(),
+                             schema_.c_str(),
+                             port_,
+                             "",
+                             0))
+      {
+        connectionPool[handle].connectedFlag = true;
+      }
+      else
+      {
+          // Unable to connect.
+
+        RUNTIME_ERROR(processError(handle));
+      }
+    }
+  }
+
+  /// @brief      Executes a statement with ? placeholders. A statement shape that is seldom used is sent as a single text query
+  ///             with the values interpolated as escaped literals, saving the prepare round trip. Once a shape that does not
+  ///             return rows has been used PREPARE_THRESHOLD times it is executed as a cached prepared statement. Statements that
+  ///             return rows always use the text protocol, as their results are read through the row cursor, as do statements
+  ///             the server will not prepare (ER_UNSUPPORTED_PS).
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  sql: The statement with the placeholders.
+  /// @param[in]  parameters: The parameter values, in placeholder order.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::parameterQuery(handle_t handle, std::string const &sql, std::vector<CVariant> const &parameters)
+  {
+    handleClaim_t claim(*this, handle);
+
+    auto &shapeCache = connectionPool[handle].cold->shapeCache;
+    auto iterator = shapeCache.find(sql);
+
+    if (iterator == shapeCache.end())
+    {
+      if (shapeCache.size() >= SHAPE_CACHE_SIZE)
+      {
+        shapeCache.erase(shapeCache.begin());
+      };
+      iterator = shapeCache.emplace(sql, shape_t{}).first;
+    };
+
+    shape_t &shape = iterator->second;
+
+    if (shape.useCount < PREPARE_THRESHOLD)
+    {
+      shape.useCount++;
+    };
+
+    bool prepared = false;
+
+    if ((shape.useCount >= PREPARE_THRESHOLD) && shape.resultKnown && !shape.returnsRows && shape.promotable)
+    {
+      try
+      {
+        processPrepareQuery(handle, sql);
+        prepared = true;
+      }
+      catch(std::exception const &)
+      {
+          // The statement ran as text, but the server will not prepare it. The shape stays on the text protocol.
+
+        shape.promotable = false;
+      }
+    };
+
+    if (prepared)
+    {
+      statement_t &statement = *connectionPool[handle].statement;
+
+      if (parameters.size() != statement.parameters.size())
+      {
+        RUNTIME_ERROR("Parameters do not match the statement placeholders.");
+      };
+
+      for (auto const &parameter : parameters)
+      {
+        if (storeParameter(statement, connectionPool[handle].bindIndex++, parameter))
+        {
+          statement.bound = false;
+        };
+      };
+
+      processExec(handle);
+    }
+    else
+    {
+      openConnection(handle);     // Needed for the character set used to escape the values.
+      interpolateQuery(handle, sql, parameters);
+      processQuery(handle, connectionPool[handle].cold->sqlBuffer);
+
+      shape.returnsRows = (mysql_field_count(connectionPool[handle].mysql) != 0);
+      shape.resultKnown = true;
+    };
+  }
+
+  /// @brief Adds a positional binding value.
+  /// @param[in] handle: The connection handle in use.
+  /// @param[in] v: The value to bind.
+  /// @param[in] pt: The type of parameter.
+  /// @throws
+  /// @version 2022-10-20/GGB - Function created.
+  /// @version 2026-10-19/GGB - Input values are written directly into the prepared statement's parameter storage.
+
+  void CMariaDBConnector::processAddBindValue(handle_t handle, CVariant const &bindValue)
+  {
+    handleClaim_t claim(*this, handle);
+
+    if ( (bindValue.paramType() == PT_IN) || (bindValue.paramType() == PT_INOUT) )
+    {
+      statement_t *statement = connectionPool[handle].statement;
+
+      if (!statement)
+      {
+        RUNTIME_ERROR("No statement prepared.");
+      }
+      else if (connectionPool[handle].bindIndex >= statement->parameters.size())
+      {
+        RUNTIME_ERROR("More bind values than statement parameters.");
+      };
+
+      if (storeParameter(*statement, connectionPool[handle].bindIndex++, bindValue))
+      {
+        statement->bound = false;
+      };
+    };
+
+    if ( (bindValue.paramType() == PT_OUT) || (bindValue.paramType() == PT_INOUT) )
+    {
+      connectionPool[handle].cold->outputParameters.push_back(bindValue);
+    }
+  }
+
+
+  /// @brief      Begins a transaction. Starts by opening the connection if required and then sending a "START TRANSACTION" to the
+  ///             server.
+  /// @param[in]  handle: The connection handle to use.
+  /// @throws
+  /// @version    2022-09-28/GGB - Function created.
+
+  void CMariaDBConnector::processBeginTransaction(handle_t handle)
+  {
+    handleClaim_t claim(*this, handle);
+
+    std::string const STARTTRANSACTION = "START TRANSACTION";
+
+      // Create the 'real' connection if not already created.
+
+    openConnection(handle);
+
+    DEBUGMESSAGE(STARTTRANSACTION);
+
+    if (!mysql_real_query(connectionPool[handle].mysql, STARTTRANSACTION.c_str(), STARTTRANSACTION.length()))
+    {
+      connectionPool[handle].tip = true;
+      connectionPool[handle].transactionClaim = true;
+      connectionPool[handle].cold->transactionStart = std::chrono::steady_clock::now();
+    }
+    else
+    {
+        // Error.
+
+      RUNTIME_ERROR(processError(handle));
+    }
+  }
+
+  /// @brief      Commits the current transaction.
+  /// @param[in]  handle: The connection handle
+  /// @throws
+  /// @version    2022-09-28/GGB - Function created.
+
+  void CMariaDBConnector::processCommitTransaction(handle_t handle)
+  {
+    handleClaim_t claim(*this, handle);
+
+    std::string const COMMITTRANSACTION = "COMMIT";
+
+    int result = mysql_real_query(connectionPool[handle].mysql, COMMITTRANSACTION.c_str(), COMMITTRANSACTION.length());
+
+      // The transaction has ended whether or not the commit succeeded. The claim is released when 'claim' goes out of scope.
+
+    connectionPool[handle].tip = false;
+    connectionPool[handle].transactionClaim = false;
+
+    if (result)
+    {
+      std::string errorText = processError(handle);
+
+      releaseResult(handle);
+      RUNTIME_ERROR(errorText);
+    }
+
+    releaseResult(handle);
+
+    DEBUGMESSAGE("COMMIT TRANSACTION");
+
+    recordPhase(PHASE_TRANSACTION, std::chrono::steady_clock::now() - connectionPool[handle].cold->transactionStart);
+  }
+
+  /// @brief Ends a transaction.
+  /// @param[in] handle: The connection handle.
+  /// @throws
+  /// @version 2022-10-29/GGB - Function created.
+
+  void CMariaDBConnector::processEndTransaction(handle_t handle)
+  {
+    if (connectionPool[handle].tip)
+    {
+      processCommitTransaction(handle);
+      connectionPool[handle].tip = false;
+    }
+  }
+
+  /// @brief      Clears the deadline after the query and its results have been read. The watchdog holds the handle's
+  ///             deadlineMutex while it sends a kill, so once this returns a late kill can no longer reach the next query on
+  ///             the handle. Only a kill of this handle can delay it.
+  /// @param[in]  handle: The connection pool handle.
+  /// @returns    true if the query was killed by the watchdog.
+  /// @version    2026-10-19/GGB - Function created.
+
+  bool CMariaDBConnector::disarmDeadline(handle_t handle)
+  {
+    connectionCold_t &cold = *connectionPool[handle].cold;
+    std::lock_guard<std::mutex> lock(cold.deadlineMutex);
+
+    cold.queryDeadline = std::chrono::steady_clock::time_point::max();
+    ++cold.deadlineGeneration;
+    return cold.queryKilled;
+  }
+
+  /// @brief      Disables the slow query log. The entries already recorded are retained.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::disableSlowQueryLog()
+  {
+    slowQueryThreshold.store(INT64_MAX, std::memory_order_release);
+  }
+
+  /// @brief      Enables a coalesced writer for single-row inserts into a table. Rows queued with coalescedInsert() by any
+  ///             thread within the window are written together as one multi-row INSERT, so concurrent callers share a round
+  ///             trip and a commit. The handle is used by the writer's flusher thread and should not be used for anything else.
+  /// @param[in]  handle: The connection pool handle to write on.
+  /// @param[in]  tableName: The table to insert into.
+  /// @param[in]  columnNames: The columns supplied by each row.
+  /// @param[in]  maxRows: The largest number of rows written in one statement. A full batch is written without waiting.
+  ///             Statements are also kept below the server's max_allowed_packet.
+  /// @param[in]  window: How long to wait after the first row for others to arrive.
+  /// @returns    The writer to pass to coalescedInsert().
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::size_t CMariaDBConnector::enableCoalescedInsert(handle_t handle, std::string const &tableName,
+                                                       std::vector<std::string> const &columnNames, std::size_t maxRows,
+                                                       std::chrono::microseconds window)
+  {
+    if (columnNames.empty() || (maxRows == 0))
+    {
+      RUNTIME_ERROR("Coalesced insert requires at least one column and one row.");
+    };
+
+    auto writer = std::make_unique<coalescedWriter_t>();
+
+    writer->handle = handle;
+    writer->columnCount = columnNames.size();
+    writer->maxRows = maxRows;
+    writer->window = window;
+
+    writer->prefix = "INSERT INTO " + quoteIdentifier(tableName) + " (";
+    for (std::size_t index = 0; index < columnNames.size(); ++index)
+    {
+      if (index != 0)
+      {
+        writer->prefix += ", ";
+      };
+      writer->prefix += quoteIdentifier(columnNames[index]);
+    };
+    writer->prefix += ") VALUES ";
+
+      // Statements must fit in the server's max_allowed_packet. Failed statements can only be retried row by row if the table's
+      // engine is transactional.
+
+    {
+      handleClaim_t claim(*this, handle);
+
+      openConnection(handle);
+
+      std::string &sqlBuffer = connectionPool[handle].cold->sqlBuffer;
+      std::size_t separator = tableName.find('.');
+
+      sqlBuffer = "SELECT @@max_allowed_packet, (SELECT e.TRANSACTIONS FROM information_schema.TABLES t "
+                  "JOIN information_schema.ENGINES e ON e.ENGINE = t.ENGINE WHERE t.TABLE_SCHEMA = ";
+      if (separator == std::string::npos)
+      {
+        sqlBuffer += "DATABASE() AND t.TABLE_NAME = ";
+        appendLiteral(handle, CVariant(tableName));
+      }
+      else
+      {
+        appendLiteral(handle, CVariant(tableName.substr(0, separator)));
+        sqlBuffer += " AND t.TABLE_NAME = ";
+        appendLiteral(handle, CVariant(tableName.substr(separator + 1)));
+      };
+      sqlBuffer += ')';
+
+      if (mysql_real_query(connectionPool[handle].mysql, sqlBuffer.data(), sqlBuffer.size()))
+      {
+        RUNTIME_ERROR(processError(handle));
+      };
+
+      MYSQL_RES *mysql_res = mysql_store_result(connectionPool[handle].mysql);
+
+      if (!mysql_res)
+      {
+        RUNTIME_ERROR(processError(handle));
+      };
+
+      MYSQL_ROW mysql_row = mysql_fetch_row(mysql_res);
+      std::size_t maxPacket = (mysql_row && mysql_row[0]) ? std::stoull(mysql_row[0]) : 0;
+
+      writer->maxBytes = (maxPacket > COALESCE_PACKET_MARGIN) ? maxPacket - COALESCE_PACKET_MARGIN : maxPacket;
+      writer->transactional = mysql_row && mysql_row[1] && (std::strcmp(mysql_row[1], "YES") == 0);
+
+      mysql_free_result(mysql_res);
+    }
+
+    std::lock_guard<std::mutex> lock(coalesceMutex);
+
+    writer->thread = std::thread(&CMariaDBConnector::coalesceFlusher, this, std::ref(*writer));
+    coalescedWriters.push_back(std::move(writer));
+
+    return coalescedWriters.size() - 1;
+  }
+
+  /// @brief      Enables the slow query log. Statements taking longer than the threshold are recorded with an EXPLAIN of the
+  ///             statement.
+  /// @param[in]  threshold: Statements taking at least this long are recorded.
+  /// @param[in]  capacity: The number of entries retained. Only used when the log is first enabled.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::enableSlowQueryLog(std::chrono::microseconds threshold, std::size_t capacity)
+  {
+    {
+      std::lock_guard<std::mutex> lock(explainMutex);
+
+      if (!slowQueryLog)
+      {
+        slowQueryLog = std::make_unique<CSlowQueryLog>(capacity);
+        explainThread = std::thread(&CMariaDBConnector::explainer, this);
+      };
+    }
+
+    slowQueryThreshold.store(std::chrono::duration_cast<std::chrono::nanoseconds>(threshold).count(), std::memory_order_release);
+  }
+
+  /// @brief      Explain thread. Runs the EXPLAIN for each queued slow statement on the side connection and then records it, so
+  ///             the round trip (and any reconnect) is not added to the statement that was slow. Entries still queued when the
+  ///             connector is destroyed are recorded without an EXPLAIN.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::explainer()
+  {
+    threadAttach();
+
+    std::unique_lock<std::mutex> lock(explainMutex);
+
+    for (;;)
+    {
+      explainCondition.wait(lock, [this] { return explainStop || !explainQueue.empty(); });
+
+      if (explainStop)
+      {
+        break;
+      };
+
+      CSlowQueryLog::entry_t entry = std::move(explainQueue.front());
+      explainQueue.pop_front();
+      lock.unlock();
+
+      entry.explain = explainQuery(entry.sql);
+      slowQueryLog->record(entry);
+
+      lock.lock();
+    };
+
+    for (auto &entry : explainQueue)
+    {
+      entry.explain = "Not explained. (Connector closed)";
+      slowQueryLog->record(entry);
+    };
+    explainQueue.clear();
+  }
+
+  /// @brief      Runs EXPLAIN for a statement on the side connection. Called on the explain thread only.
+  /// @param[in]  sql: The statement to explain.
+  /// @returns    The EXPLAIN output, or the reason it is not available.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::string CMariaDBConnector::explainQuery(std::string const &sql)
+  {
+    std::string returnValue;
+
+      // Only these statements can be explained.
+
+    std::size_t start = sql.find_first_not_of(" \t\r\n(");
+    std::string keyword;
+
+    for (std::size_t index = start; (index < sql.size()) && std::isalpha(static_cast<unsigned char>(sql[index])); ++index)
+    {
+      keyword += static_cast<char>(std::toupper(static_cast<unsigned char>(sql[index])));
+    };
+
+    if ((keyword != "SELECT") && (keyword != "WITH") && (keyword != "INSERT") && (keyword != "REPLACE") &&
+        (keyword != "UPDATE") && (keyword != "DELETE"))
+    {
+      return "Not explainable.";
+    };
+
+    if (!explainConnection)
+    {
+      explainConnection = mysql_init(nullptr);
+
+      if (!mysql_real_connect(explainConnection, host_.c_str(), user_.c_str(), passwd_.c_str(), schema_.c_str(), port_, "", 0))
+      {
+        returnValue = "Unable to connect: " + std::string(mysql_error(explainConnection));
+        mysql_close(explainConnection);
+        explainConnection = nullptr;
+        return returnValue;
+      };
+    };
+
+    std::string query = "EXPLAIN " + sql;
+
+    if (mysql_real_query(explainConnection, query.c_str(), query.length()))
+    {
+      returnValue = "EXPLAIN failed: " + std::string(mysql_error(explainConnection));
+    }
+    else if (MYSQL_RES *mysql_res = mysql_store_result(explainConnection))
+    {
+      unsigned int fieldCount = mysql_num_fields(mysql_res);
+      MYSQL_FIELD *fields = mysql_fetch_fields(mysql_res);
+
+      for (unsigned int index = 0; index < fieldCount; ++index)
+      {
+        returnValue += (index ? "\t" : "");
+        returnValue.append(fields[index].name, fields[index].name_length);
+      };
+
+      while (MYSQL_ROW mysql_row = mysql_fetch_row(mysql_res))
+      {
+        unsigned long *lengths = mysql_fetch_lengths(mysql_res);
 
-    connectionPool[handle].validRecord = false;
-  }
+        returnValue += '\n';
+        for (unsigned int index = 0; index < fieldCount; ++index)
+        {
+          returnValue += (index ? "\t" : "");
+          if (mysql_row[index])
+          {
+            returnValue.append(mysql_row[index], lengths[index]);
+          }
+          else
+          {
+            returnValue += "NULL";
+          };
+        };
+      };
 
-  /// @brief Ends a transaction.
-  /// @param[in] handle: The connection handle.
-  /// @throws
-  /// @version 2022-10-29/GGB - Function created.
+      mysql_free_result(mysql_res);
+    };
 
-  void CMariaDBConnector::processEndTransaction(handle_t handle)
-  {
-    if (connectionPool[handle].tip)
-    {
-      processCommitTransaction(handle);
-      connectionPool[handle].tip = false;
-    }
+    return returnValue;
   }
 
   /// @brief Processes an error, by loading the error number and code.
@@ -326,42 +1769,75 @@ namespace database
     return std::to_string(errorNo) + " - " + errorText;
   }
 
-  /// @brief Executes a prepared statement. The statement is prepared, variables assigned and executed in this function.
+  /// @brief Executes the prepared statement with the values bound since it was prepared or last executed.
   /// @throws
   /// @version 2022-10-20/GGB - Function created.
+  /// @version 2026-10-19/GGB - The statement is prepared by processPrepareQuery() and the parameters are only rebound if changed.
 
   void CMariaDBConnector::processExec(handle_t handle)
   {
-    if (!connectionPool[handle].prepareStatement)
+    handleClaim_t claim(*this, handle);
+
+    statement_t *statement = connectionPool[handle].statement;
+
+    if (!connectionPool[handle].prepareStatement || !statement)
     {
       RUNTIME_ERROR("No statement prepared.");
     }
 
-    connectionPool[handle].mysql_stmt = mysql_stmt_init(connectionPool[handle].mysql);
-
-    if (mysql_stmt_prepare(connectionPool[handle].mysql_stmt,
-                           connectionPool[handle].preparedStatement.c_str(),
-                           connectionPool[handle].preparedStatement.length()))
+    if (connectionPool[handle].bindIndex != statement->parameters.size())
     {
-      RUNTIME_ERROR(processError(handle));
+      RUNTIME_ERROR("Bind values do not match the statement parameters.");
     }
+    connectionPool[handle].bindIndex = 0;
 
-    createInputParameters(handle);
+      // The bind array only needs to be passed again if a parameter changed type or buffer.
 
-    if (!mysql_stmt_bind_param(connectionPool[handle].mysql_stmt,
-                               connectionPool[handle].mysql_bind.get()))
+    if (!statement->bound && !statement->parameters.empty())
     {
-      RUNTIME_ERROR(processError(handle));
+      if (mysql_stmt_bind_param(statement->mysql_stmt, statement->bind.data()))
+      {
+        RUNTIME_ERROR(processStatementError(handle));
+      }
+      statement->bound = true;
     }
 
-    if (mysql_stmt_execute(connectionPool[handle].mysql_stmt))
+    bool timed = connectionPool[handle].cold->queryTimeout.count() > 0;
+    if (timed)
     {
-      RUNTIME_ERROR(processError(handle));
+      armDeadline(handle);
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+    int errorCode = mysql_stmt_execute(statement->mysql_stmt);
+    auto endTime = std::chrono::steady_clock::now();
+
+    if (timed && disarmDeadline(handle) && errorCode)
+    {
+      throw CQueryTimeout("Query cancelled at deadline: " + processStatementError(handle));
+    };
+
+    if (errorCode)
+    {
+      RUNTIME_ERROR(processStatementError(handle));
     }
 
-    if (!connectionPool[handle].outputParameters.empty())
+    if ((endTime - startTime).count() >= slowQueryThreshold.load(std::memory_order_acquire))
+    {
+      recordSlowQuery(handle, statement->sql, true, startTime, endTime, endTime);
+    };
+
+    recordPhase(PHASE_EXECUTE, endTime - startTime);
+
+    if (connectionPool[handle].cold->outputParameters.empty())
     {
-      if ((connectionPool[handle].mysql_res = mysql_stmt_result_metadata(connectionPool[handle].mysql_stmt)))
+        // Discard any result so the statement can be executed again.
+
+      mysql_stmt_free_result(statement->mysql_stmt);
+    }
+    else
+    {
+      if ((connectionPool[handle].mysql_res = mysql_stmt_result_metadata(statement->mysql_stmt)))
       {
           // Process the results from the query.
 
@@ -371,6 +1847,7 @@ namespace database
       {
         RUNTIME_ERROR("Output Parameters specified, but query does/did not produce a result.");
       }
+      connectionPool[handle].cold->outputParameters.clear();
     }
 
   }
@@ -410,6 +1887,8 @@ namespace database
 
   void CMariaDBConnector::processGetRecordSet(handle_t handle, ::database::CRecordSet &recordSet)
   {
+    handleClaim_t claim(*this, handle);
+
     recordSet.clear();
     recordSet.resize(connectionPool[handle].rowCount);
 
@@ -419,7 +1898,13 @@ namespace database
     DEBUGMESSAGE("ProcessGetRecordSet");
 #endif
 
-    if (moveFirst(handle))
+    auto startTime = std::chrono::steady_clock::now();
+
+    if ((connectionPool[handle].rowCount >= parallelDecodeThreshold) && (std::thread::hardware_concurrency() > 1))
+    {
+      decodeParallel(handle, recordSet);
+    }
+    else if (moveFirst(handle))
     {
       do
       {
@@ -427,6 +1912,8 @@ namespace database
       }
       while (moveNext(handle));
     }
+
+    recordPhase(PHASE_DECODE, std::chrono::steady_clock::now() - startTime);
   }
 
   /// @brief      Moves the rowCursor to the next row and loads the data.
@@ -467,13 +1954,39 @@ namespace database
     return returnValue;
   }
 
+  /// @brief      Moves the rowCursor to the last row and loads the data.
+  /// @param[in]  handle: The connectionPool handle.
+  /// @returns    true if there is a last row.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  bool CMariaDBConnector::processMoveLast(handle_t handle)
+  {
+    bool returnValue = false;
+
+    if (connectionPool[handle].rowCount > 0)
+    {
+      connectionPool[handle].rowCursorRequested = connectionPool[handle].rowCount - 1;
+      loadRow(handle);
+      returnValue = true;
+    }
+
+    return returnValue;
+  }
+
+  /// @brief      Moves the rowCursor to the previous row and loads the data.
+  /// @param[in]  handle: The connectionPool handle.
+  /// @returns    true if there is a previous row.
+  /// @throws
+  /// @version    2026-10-19/GGB - Move the requested cursor, not the actual cursor.
+
   bool CMariaDBConnector::processMovePrevious(handle_t handle)
   {
     bool returnValue = false;
 
     if (connectionPool[handle].rowCursorRequested != 0)
     {
-      connectionPool[handle].rowCursorActual--;
+      connectionPool[handle].rowCursorRequested--;
       loadRow(handle);
       returnValue = true;
     };
@@ -481,19 +1994,457 @@ namespace database
     return returnValue;
   }
 
+  /// @brief      Reads the result unbuffered into the row store of the handle. Used in place of mysql_store_result() when a
+  ///             result or pool budget is set, so that the size of the result held in memory is limited by the budget.
+  /// @param[in]  handle: The connection pool handle.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::storeRows(handle_t handle)
+  {
+    connection_t &connection = connectionPool[handle];
+    std::unique_ptr<CRowStore> &rowStore = connection.cold->rowStore;
+    std::size_t resultBudget = connection.cold->resultBudget;
+    std::size_t poolBudget = poolResultBudget.load();
+
+    if (!rowStore)
+    {
+      rowStore = std::make_unique<CRowStore>(resultMemory);
+    };
+    rowStore->reset((resultBudget != 0) ? resultBudget : SIZE_MAX, (poolBudget != 0) ? poolBudget : SIZE_MAX);
+
+    connection.mysql_res = mysql_use_result(connection.mysql);
+
+    if (!connection.mysql_res)
+    {
+      RUNTIME_ERROR("Unable to retrieve query results.");
+    };
+
+    try
+    {
+      while (MYSQL_ROW mysql_row = mysql_fetch_row(connection.mysql_res))
+      {
+        rowStore->append(mysql_row, mysql_fetch_lengths(connection.mysql_res), connection.columnCount);
+      };
+
+        // mysql_fetch_row() also returns nullptr if the connection fails part way through.
+
+      if (mysql_errno(connection.mysql))
+      {
+        RUNTIME_ERROR(processError(handle));
+      };
+    }
+    catch(...)
+    {
+      mysql_free_result(connection.mysql_res);    // Reads and discards any remaining rows so the connection can be reused.
+      connection.mysql_res = nullptr;
+      rowStore->clear();
+      throw;
+    }
+
+      // The field descriptions remain with the (now empty) result.
+
+    connection.mysql_field = mysql_fetch_fields(connection.mysql_res);
+    connection.rowCount = rowStore->rows();
+    connection.rowStoreResult = true;
+    connection.cold->rowValues.resize(connection.columnCount);
+    connection.cold->rowLengths.resize(connection.columnCount);
+
+#ifdef DEBUG_ON
+    DEBUGMESSAGE("Row Count: " + std::to_string(connection.rowCount) + (rowStore->spilled() ? " (spilled)" : ""));
+#endif
+  }
+
+  /// @brief      Writes a bind value into the storage for a parameter of a prepared statement and sets up the MYSQL_BIND for it.
+  ///             The value is written in place. Only a change of type, or a string that outgrows its buffer, changes the
+  ///             MYSQL_BIND and needs the parameters to be bound again.
+  /// @param[in]  statement: The statement.
+  /// @param[in]  index: The index of the parameter.
+  /// @param[in]  value: The value to bind.
+  /// @returns    true if the MYSQL_BIND was changed.
+  /// @throws
+  /// @version    2022-10-25/GGB - Function created. (createInputParameters)
+  /// @version    2026-10-19/GGB - Write the values into the retained parameter storage.
+
+  bool CMariaDBConnector::storeParameter(statement_t &statement, std::size_t index, CVariant const &value)
+  {
+    parameter_t &parameter = statement.parameters[index];
+    MYSQL_BIND &bind = statement.bind[index];
+    variantType_t type = value.type();
+    bool returnValue = !parameter.assigned || (parameter.type != type);
+
+    enum_field_types fieldType = MYSQL_TYPE_NULL;
+    bool unsignedValue = false;
+    void *buffer = &parameter.scalar;
+    unsigned long bufferLength = 0;
+
+    auto setTime = [&parameter](Wt::WDate const *date, Wt::WTime const *time, enum_mysql_timestamp_type timeType)
+    {
+      parameter.scalar.time = MYSQL_TIME{};
+      if (date)
+      {
+        parameter.scalar.time.year = date->year();
+        parameter.scalar.time.month = date->month();
+        parameter.scalar.time.day = date->day();
+      };
+      if (time)
+      {
+        parameter.scalar.time.hour = time->hour();
+        parameter.scalar.time.minute = time->minute();
+        parameter.scalar.time.second = time->second();
+        parameter.scalar.time.second_part = time->msec() * 1000;
+      };
+      parameter.scalar.time.time_type = timeType;
+    };
+
+    parameter.isNull = 0;
+
+    switch(type)
+    {
+      case BIT:
+      {
+        fieldType = MYSQL_TYPE_LONGLONG;
+        unsignedValue = true;
+        parameter.scalar.u64 = static_cast<boost::dynamic_bitset<>>(value).to_ulong();
+        bufferLength = sizeof(std::uint64_t);
+        break;
+      }
+      case BLOB:
+      {
+        fieldType = MYSQL_TYPE_BLOB;
+
+        std::string_view bytes = variantBytes(value);
+        parameter.text.assign(bytes.data(), bytes.size());
+        buffer = parameter.text.data();
+        bufferLength = parameter.text.size();
+        break;
+      }
+      case U8:
+      {
+        fieldType = MYSQL_TYPE_TINY;
+        unsignedValue = true;
+        parameter.scalar.u8 = static_cast<std::uint8_t>(value);
+        bufferLength = sizeof(std::uint8_t);
+        break;
+      };
+      case I8:
+      {
+        fieldType = MYSQL_TYPE_TINY;
+        parameter.scalar.i8 = static_cast<std::int8_t>(value);
+        bufferLength = sizeof(std::int8_t);
+        break;
+      };
+      case U16:
+      {
+        fieldType = MYSQL_TYPE_SHORT;
+        unsignedValue = true;
+        parameter.scalar.u16 = static_cast<std::uint16_t>(value);
+        bufferLength = sizeof(std::uint16_t);
+        break;
+      }
+      case I16:
+      {
+        fieldType = MYSQL_TYPE_SHORT;
+        parameter.scalar.i16 = static_cast<std::int16_t>(value);
+        bufferLength = sizeof(std::int16_t);
+        break;
+      }
+      case U32:
+      {
+        fieldType = MYSQL_TYPE_LONG;
+        unsignedValue = true;
+        parameter.scalar.u32 = static_cast<std::uint32_t>(value);
+        bufferLength = sizeof(std::uint32_t);
+        break;
+      }
+      case I32:
+      {
+        fieldType = MYSQL_TYPE_LONG;
+        parameter.scalar.i32 = static_cast<std::int32_t>(value);
+        bufferLength = sizeof(std::int32_t);
+        break;
+      }
+      case U64:
+      {
+        fieldType = MYSQL_TYPE_LONGLONG;
+        unsignedValue = true;
+        parameter.scalar.u64 = static_cast<std::uint64_t>(value);
+        bufferLength = sizeof(std::uint64_t);
+        break;
+      }
+      case I64:
+      {
+        fieldType = MYSQL_TYPE_LONGLONG;
+        parameter.scalar.i64 = static_cast<std::int64_t>(value);
+        bufferLength = sizeof(std::int64_t);
+        break;
+      }
+      case FLOAT:
+      {
+        fieldType = MYSQL_TYPE_FLOAT;
+        parameter.scalar.f = static_cast<float>(value);
+        bufferLength = sizeof(float);
+        break;
+      }
+      case DOUBLE:
+      {
+        fieldType = MYSQL_TYPE_DOUBLE;
+        parameter.scalar.d = static_cast<double>(value);
+        bufferLength = sizeof(double);
+        break;
+      }
+      case STRING:
+      {
+        fieldType = MYSQL_TYPE_STRING;
+
+          // Copied straight from the variant's buffer into the retained capacity, without a temporary string.
+
+        std::string_view bytes = variantBytes(value);
+        parameter.text.assign(bytes.data(), bytes.size());
+        buffer = parameter.text.data();
+        bufferLength = parameter.text.size();
+        break;
+      }
+      case DECIMAL:
+      {
+          // The variant holds the decimal in binary, so it has to be formatted. The text is written into the retained
+          // capacity.
+
+        fieldType = MYSQL_TYPE_NEWDECIMAL;
+        parameter.text.clear();
+        variantText(value, parameter.text);
+        buffer = parameter.text.data();
+        bufferLength = parameter.text.size();
+        break;
+      }
+      case NULLVALUE:
+      {
+        fieldType = MYSQL_TYPE_NULL;
+        parameter.isNull = 1;
+        break;
+      }
+      case BOOL:
+      {
+        fieldType = MYSQL_TYPE_TINY;
+        parameter.scalar.i8 = static_cast<bool>(value) ? 1 : 0;
+        bufferLength = sizeof(std::int8_t);
+        break;
+      }
+      case DATE:
+      {
+        Wt::WDate date = static_cast<Wt::WDate>(value);
+
+        fieldType = MYSQL_TYPE_DATE;
+        setTime(&date, nullptr, MYSQL_TIMESTAMP_DATE);
+        bufferLength = sizeof(MYSQL_TIME);
+        break;
+      }
+      case TIME:
+      {
+        Wt::WTime time = static_cast<Wt::WTime>(value);
+
+        fieldType = MYSQL_TYPE_TIME;
+        setTime(nullptr, &time, MYSQL_TIMESTAMP_TIME);
+        bufferLength = sizeof(MYSQL_TIME);
+        break;
+      }
+      case DATETIME:
+      {
+        Wt::WDateTime dateTime = static_cast<Wt::WDateTime>(value);
+        Wt::WDate date = dateTime.date();
+        Wt::WTime time = dateTime.time();
+
+        fieldType = MYSQL_TYPE_DATETIME;
+        setTime(&date, &time, MYSQL_TIMESTAMP_DATETIME);
+        bufferLength = sizeof(MYSQL_TIME);
+        break;
+      }
+      default:
+      {
+        CODE_ERROR();
+      }
+    };
+
+    parameter.type = type;
+    parameter.assigned = true;
+    parameter.length = bufferLength;
+
+      // The length and is_null are read through pointers when the statement is executed, so only the buffer and its type
+      // are captured by mysql_stmt_bind_param().
+
+    returnValue = returnValue || (bind.buffer != buffer) || (bind.buffer_type != fieldType);
+
+    bind.buffer_type = fieldType;
+    bind.buffer = buffer;
+    bind.buffer_length = bufferLength;
+    bind.is_unsigned = unsignedValue;
+
+    return returnValue;
+  }
+
+  /// @brief      Returns the latency summary for a phase. Statistics are shared by all the handles in the pool, so a load
+  ///             generator driving the pool from several threads can read the combined throughput and tail latency here.
+  /// @param[in]  phase: The phase.
+  /// @returns    The count, rate and percentiles.
+  /// @version    2026-10-19/GGB - Function created.
+
+  phaseStatistics_t CMariaDBConnector::statistics(latencyPhase_e phase) const
+  {
+    phaseStatistics_t returnValue;
+    CLatencyHistogram const &histogram = phaseLatency[phase];
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now().time_since_epoch() -
+                                            std::chrono::steady_clock::duration(statisticsStart.load());
+
+    returnValue.count = histogram.count();
+    returnValue.ratePerSecond = (elapsed.count() > 0) ? returnValue.count / elapsed.count() : 0;
+    returnValue.p50 = histogram.percentile(0.5);
+    returnValue.p99 = histogram.percentile(0.99);
+    returnValue.p999 = histogram.percentile(0.999);
+    returnValue.max = histogram.max();
+
+    return returnValue;
+  }
+
+  /// @brief      Returns the entries in the slow query log, oldest first.
+  /// @returns    The entries. Empty if the log has never been enabled.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::vector<CSlowQueryLog::entry_t> CMariaDBConnector::slowQueries() const
+  {
+    if (slowQueryLog)
+    {
+      return slowQueryLog->entries();
+    }
+    else
+    {
+      return {};
+    };
+  }
+
+  /// @brief      Sets the number of rows at which processGetRecordSet() changes to the parallel decode. Below this the cost of
+  ///             starting the threads is greater than the decoding time.
+  /// @param[in]  threshold: The minimum number of rows.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::setParallelDecodeThreshold(std::uint64_t threshold)
+  {
+    parallelDecodeThreshold = std::max<std::uint64_t>(threshold, 2);
+  }
+
+  /// @brief      Sets the memory that all the results of the pool together may hold before further results spill to disk. When
+  ///             a budget is set, results are read as they are returned by the server rather than stored by the client library.
+  /// @param[in]  budget: The limit in bytes. Zero for no limit.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::setPoolResultBudget(std::size_t budget)
+  {
+    poolResultBudget.store(budget);
+  }
+
+  /// @brief      Sets the time limit for queries on the handle. Queries still running at the deadline are killed on the server
+  ///             and CQueryTimeout is thrown. The limit applies until it is changed.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  timeout: The time limit. Zero for no limit.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::setQueryTimeout(handle_t handle, std::chrono::milliseconds timeout)
+  {
+    std::lock_guard<std::mutex> lock(watchdogMutex);
+
+    connectionPool[handle].cold->queryTimeout = timeout;
+
+    if ((timeout.count() > 0) && !watchdogThread.joinable())
+    {
+      watchdogThread = std::thread(&CMariaDBConnector::watchdog, this);
+    };
+  }
+
+  /// @brief      Sets the memory a result on the handle may hold. A larger result is moved to a memory mapped temporary file and
+  ///             the cursor functions continue to work on it, at disk speed.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  budget: The limit in bytes. Zero for no limit.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::setResultBudget(handle_t handle, std::size_t budget)
+  {
+    connectionPool[handle].cold->resultBudget = budget;
+  }
+
   /// @brief Prepares a prepared statement.
   /// @param[in] handle: The connection pool handle.
   /// @param[in] sqlQuery: The query containing the binding placeholders.
   /// @returns true if no errors.
   /// @throws
   /// @version 2022-10-20/GGB - Function created.
+  /// @version 2026-10-19/GGB - Statements are prepared once and retained in the connection's statement cache.
 
   bool CMariaDBConnector::processPrepareQuery(handle_t handle, std::string const &sqlQuery)
   {
+    handleClaim_t claim(*this, handle);
+
+    auto &statementCache = connectionPool[handle].cold->statementCache;
+    auto iterator = statementCache.find(sqlQuery);
+
+    if (iterator == statementCache.end())
+    {
+      openConnection(handle);
+
+      if (statementCache.size() >= STATEMENT_CACHE_SIZE)
+      {
+        if (connectionPool[handle].statement == statementCache.begin()->second.get())
+        {
+          connectionPool[handle].statement = nullptr;
+        };
+        mysql_stmt_close(statementCache.begin()->second->mysql_stmt);
+        statementCache.erase(statementCache.begin());
+      };
+
+      auto statement = std::make_unique<statement_t>();
+
+      statement->sql = sqlQuery;
+      statement->mysql_stmt = mysql_stmt_init(connectionPool[handle].mysql);
+
+      if (mysql_stmt_prepare(statement->mysql_stmt, sqlQuery.c_str(), sqlQuery.length()))
+      {
+        std::string errorText = std::to_string(mysql_stmt_errno(statement->mysql_stmt)) + " - " +
+                                mysql_stmt_error(statement->mysql_stmt);
+        mysql_stmt_close(statement->mysql_stmt);
+        RUNTIME_ERROR(errorText);
+      }
+
+        // The parameter storage is never resized after this, so the pointers in the bind array remain valid.
+
+      std::size_t parameterCount = mysql_stmt_param_count(statement->mysql_stmt);
+
+      statement->bind.resize(parameterCount, MYSQL_BIND{});
+      statement->parameters.resize(parameterCount);
+      for (std::size_t index = 0; index < parameterCount; ++index)
+      {
+        statement->bind[index].length = &statement->parameters[index].length;
+        statement->bind[index].is_null = &statement->parameters[index].isNull;
+      };
+
+      iterator = statementCache.emplace(sqlQuery, std::move(statement)).first;
+    };
+
+    connectionPool[handle].statement = iterator->second.get();
+    connectionPool[handle].bindIndex = 0;
+    connectionPool[handle].cold->outputParameters.clear();
     connectionPool[handle].prepareStatement = true;
 
+    return true;
   }
 
+  /// @brief Processes an error from the current prepared statement.
+  /// @returns The error number and error code.
+  /// @version 2026-10-19/GGB - Function created.
+
+  std::string CMariaDBConnector::processStatementError(handle_t handle)
+  {
+    MYSQL_STMT *mysql_stmt = connectionPool[handle].statement->mysql_stmt;
+
+    return std::to_string(mysql_stmt_errno(mysql_stmt)) + " - " + mysql_stmt_error(mysql_stmt);
+  }
 
   /// @brief Process a query and stores the number of fields returned.
   /// @param[in] handle: The connection pool handle.
@@ -503,14 +2454,52 @@ namespace database
 
   void CMariaDBConnector::processQuery(handle_t handle, std::string const &query)
   {
+    handleClaim_t claim(*this, handle);
+
     DEBUGMESSAGE(query);
-    if (!mysql_real_query(connectionPool[handle].mysql, query.c_str(), query.length()))
+
+    bool timed = connectionPool[handle].cold->queryTimeout.count() > 0;
+    if (timed)
+    {
+      armDeadline(handle);
+    };
+
+    auto startTime = std::chrono::steady_clock::now();
+    int errorCode = mysql_real_query(connectionPool[handle].mysql, query.c_str(), query.length());
+    auto executeTime = std::chrono::steady_clock::now();
+
+    if (!errorCode)
     {
       connectionPool[handle].columnCount = mysql_field_count(connectionPool[handle].mysql);
 
       if (connectionPool[handle].columnCount != 0)
       {
-        processResults(handle); // This is needed to prevent the next connection failing.
+          // The deadline also covers reading the rows. A kill while they are read is reported as a timeout.
+
+        try
+        {
+          processResults(handle); // This is needed to prevent the next connection failing.
+        }
+        catch(...)
+        {
+          if (timed && disarmDeadline(handle))
+          {
+            throw CQueryTimeout("Query cancelled at deadline: " + processError(handle));
+          };
+          throw;
+        }
+      };
+    };
+
+    if (timed && disarmDeadline(handle) && errorCode)
+    {
+      throw CQueryTimeout("Query cancelled at deadline: " + processError(handle));
+    };
+
+    if (!errorCode)
+    {
+      if (connectionPool[handle].columnCount != 0)
+      {
         connectionPool[handle].rowCursorActual = 0;
         connectionPool[handle].rowCursorRequested = 0;
         if (connectionPool[handle].rowCount != 0)
@@ -518,6 +2507,18 @@ namespace database
           loadRow(handle);
         };
       };
+
+      auto endTime = std::chrono::steady_clock::now();
+      if ((endTime - startTime).count() >= slowQueryThreshold.load(std::memory_order_acquire))
+      {
+        recordSlowQuery(handle, query, false, startTime, executeTime, endTime);
+      };
+
+      recordPhase(PHASE_EXECUTE, executeTime - startTime);
+      if (connectionPool[handle].columnCount != 0)
+      {
+        recordPhase(PHASE_FETCH, endTime - executeTime);
+      };
     }
     else
     {
@@ -532,6 +2533,16 @@ namespace database
 
   void CMariaDBConnector::processResults(handle_t handle)
   {
+    releaseResult(handle);
+
+      // With a memory budget the rows are read into the row store instead.
+
+    if ((connectionPool[handle].cold->resultBudget != 0) || (poolResultBudget.load() != 0))
+    {
+      storeRows(handle);
+      return;
+    };
+
       // Check if the result is available and if not, try to load it.
 
     connectionPool[handle].mysql_res = mysql_store_result(connectionPool[handle].mysql);
@@ -553,6 +2564,166 @@ namespace database
     }
   }
 
+  /// @brief      Quotes an identifier with backticks. A '.' separates the schema from the table name.
+  /// @param[in]  identifier: The identifier to quote.
+  /// @returns    The quoted identifier.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::string CMariaDBConnector::quoteIdentifier(std::string const &identifier)
+  {
+    std::string returnValue = "`";
+
+    for (auto c : identifier)
+    {
+      if (c == '`')
+      {
+        returnValue += "``";
+      }
+      else if (c == '.')
+      {
+        returnValue += "`.`";
+      }
+      else
+      {
+        returnValue += c;
+      };
+    };
+
+    returnValue += '`';
+    return returnValue;
+  }
+
+  /// @brief      Records a statement in the slow query log. Only called once the statement has been found to be slow, so the
+  ///             cost of building the entry is not on the fast path. Statements that can be explained are queued for the
+  ///             explain thread rather than explained here; if the queue is full the entry is recorded without an EXPLAIN.
+  /// @param[in]  handle: The connection pool handle.
+  /// @param[in]  sql: The statement.
+  /// @param[in]  prepared: true if the statement is a prepared statement with bound parameters.
+  /// @param[in]  startTime: When the statement was sent.
+  /// @param[in]  executeTime: When the server call returned.
+  /// @param[in]  endTime: When the results had been retrieved.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::recordSlowQuery(handle_t handle, std::string const &sql, bool prepared,
+                                          std::chrono::steady_clock::time_point startTime,
+                                          std::chrono::steady_clock::time_point executeTime,
+                                          std::chrono::steady_clock::time_point endTime)
+  {
+    auto typeName = [](variantType_t type) -> char const *
+    {
+      switch (type)
+      {
+        case NULLVALUE: return "NULL";
+        case BIT: return "BIT";
+        case BLOB: return "BLOB";
+        case U8: return "U8";
+        case I8: return "I8";
+        case U16: return "U16";
+        case I16: return "I16";
+        case U32: return "U32";
+        case I32: return "I32";
+        case U64: return "U64";
+        case I64: return "I64";
+        case FLOAT: return "FLOAT";
+        case DOUBLE: return "DOUBLE";
+        case STRING: return "STRING";
+        case BOOL: return "BOOL";
+        case DATE: return "DATE";
+        case TIME: return "TIME";
+        case DATETIME: return "DATETIME";
+        case DECIMAL: return "DECIMAL";
+        default: return "?";
+      };
+    };
+
+    CSlowQueryLog::entry_t entry;
+
+    entry.startTime = std::chrono::system_clock::now() -
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(endTime - startTime);
+    entry.executeTime = executeTime - startTime;
+    entry.fetchTime = endTime - executeTime;
+    entry.sql = sql;
+
+    if (prepared)
+    {
+      entry.rowCount = mysql_stmt_affected_rows(connectionPool[handle].statement->mysql_stmt);
+
+      for (auto const &parameter : connectionPool[handle].statement->parameters)
+      {
+        entry.parameterTypes += (entry.parameterTypes.empty() ? "" : ",");
+        entry.parameterTypes += typeName(parameter.type);
+      };
+
+        // The statement contains placeholders and cannot be explained as it stands.
+
+      entry.explain = "Not explainable. (Prepared statement)";
+    }
+    else
+    {
+      entry.rowCount = (connectionPool[handle].columnCount != 0) ? connectionPool[handle].rowCount
+                                                                 : mysql_affected_rows(connectionPool[handle].mysql);
+
+      bool queued = false;
+
+      {
+        std::lock_guard<std::mutex> lock(explainMutex);
+
+        if (explainQueue.size() < EXPLAIN_QUEUE_SIZE)
+        {
+          explainQueue.push_back(std::move(entry));
+          queued = true;
+        };
+      }
+
+      if (queued)
+      {
+        explainCondition.notify_one();
+        return;
+      };
+
+      entry.explain = "Not explained. (Queue full)";
+    };
+
+    slowQueryLog->record(entry);
+  }
+
+  /// @brief      Releases the result of the last query on the handle. Frees the client library result and returns any row
+  ///             store memory to the pool budget. The handle no longer has a valid record.
+  /// @param[in]  handle: The connection pool handle.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::releaseResult(handle_t handle)
+  {
+    if (connectionPool[handle].mysql_res)
+    {
+      mysql_free_result(connectionPool[handle].mysql_res);
+      connectionPool[handle].mysql_res = nullptr;
+    };
+    connectionPool[handle].cold->rowOffsets.clear();
+
+    if (connectionPool[handle].rowStoreResult)
+    {
+      connectionPool[handle].cold->rowStore->clear();
+      connectionPool[handle].rowStoreResult = false;
+    };
+
+    connectionPool[handle].mysql_field = nullptr;
+    connectionPool[handle].rowCount = 0;
+    connectionPool[handle].validRecord = false;
+  }
+
+  /// @brief      Clears the latency statistics and restarts the rate calculation.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::resetStatistics()
+  {
+    for (auto &histogram : phaseLatency)
+    {
+      histogram.reset();
+    };
+    statisticsStart.store(std::chrono::steady_clock::now().time_since_epoch().count());
+  }
+
   /// @brief Rolls back the current transaction.
   /// @param[in] handle: The connectionPool handle.
   /// @throws
@@ -560,16 +2731,28 @@ namespace database
 
   void CMariaDBConnector::processRollbackTransaction(handle_t handle)
   {
-    if (!mysql_rollback(connectionPool[handle].mysql))
-    {
-      connectionPool[handle].tip = false;
-    }
-    else
+    handleClaim_t claim(*this, handle);
+
+    bool result = mysql_rollback(connectionPool[handle].mysql);
+
+      // The transaction has ended whether or not the rollback succeeded. The claim is released when 'claim' goes out of scope.
+
+    connectionPool[handle].tip = false;
+    connectionPool[handle].transactionClaim = false;
+
+    if (result)
     {
-      RUNTIME_ERROR(processError(handle));
+      std::string errorText = processError(handle);
+
+      releaseResult(handle);
+      RUNTIME_ERROR(errorText);
     };
 
+    releaseResult(handle);
+
     DEBUGMESSAGE("ROLLBACK TRANSACTION");
+
+    recordPhase(PHASE_TRANSACTION, std::chrono::steady_clock::now() - connectionPool[handle].cold->transactionStart);
   }
 
 
@@ -582,35 +2765,54 @@ namespace database
 
   ::database::CVariant CMariaDBConnector::processColumnValue(handle_t handle, std::size_t columnIndex)
   {
-    ::database::CVariant returnValue;
+    return columnValue(connectionPool[handle].mysql_field[columnIndex],
+                       connectionPool[handle].mysql_row[columnIndex],
+                       connectionPool[handle].columnLengths[columnIndex]);
+  }
 
-    bool unsignedValue = false;
+  /// @brief Converts the text value of a column into a variant. This does not access the connection state, so it can be called
+  ///        from several threads for different rows of the same result.
+  /// @param[in] field: The field description for the column.
+  /// @param[in] columnValue: The column value.
+  /// @param[in] columnLength: The length of the column value.
+  /// @returns A CVariant containing the value.
+  /// @throws
+  /// @version 2022-09-29/GGB - Function created.
+  /// @version 2026-10-19/GGB - Separated from processColumnValue() for the parallel decode.
+  /// @version 2026-10-19/GGB - NULL values are returned as a NULL variant before the type is decoded.
 
-    char *columnValue = connectionPool[handle].mysql_row[columnIndex];
-    unsigned long columnLength = connectionPool[handle].columnLengths[columnIndex];
+  ::database::CVariant CMariaDBConnector::columnValue(MYSQL_FIELD const &field, char const *columnValue,
+                                                      unsigned long columnLength)
+  {
+    ::database::CVariant returnValue;
 
-    unsignedValue = connectionPool[handle].mysql_field[columnIndex].flags & UNSIGNED_FLAG;
-    std::string columnName(connectionPool[handle].mysql_field[columnIndex].name,
-                          connectionPool[handle].mysql_field[columnIndex].name_length);
+    bool unsignedValue = field.flags & UNSIGNED_FLAG;
 
 #ifdef DEBUG_ON
+    std::string columnName(field.name, field.name_length);
+
     DEBUGMESSAGE("--- Start Column ---");
     DEBUGMESSAGE("Column Name: " + columnName);
-    DEBUGMESSAGE("Column Index: " + std::to_string(columnIndex));
     DEBUGMESSAGE("Column Length: " + std::to_string(columnLength));
     DEBUGMESSAGE("Column unsigned: " + (unsignedValue ? std::string("Yes") : std::string("No")));
 #endif
 
+      // NULL is returned by the client library as nullptr for every column type. The empty variant is NULL.
+
+    if (columnValue == nullptr)
+    {
+      return returnValue;
+    };
 
     std::string val(columnValue, columnLength);
 
 #ifdef DEBUG_ON
     DEBUGMESSAGE("Value String: '" + val + "'");
 
-    DEBUGMESSAGE("Field Type: " + std::to_string(connectionPool[handle].mysql_field[columnIndex].type));
+    DEBUGMESSAGE("Field Type: " + std::to_string(field.type));
 #endif
 
-    switch(connectionPool[handle].mysql_field[columnIndex].type)
+    switch(field.type)
     {
       case MYSQL_TYPE_DECIMAL:
       {
@@ -741,37 +2943,55 @@ namespace database
         break;
       }
 
-      case MYSQL_TYPE_TIMESTAMP:    // Needed
+      case MYSQL_TYPE_TIMESTAMP:
+      case MYSQL_TYPE_TIMESTAMP2:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_DATETIME2:
       {
-        DEBUGMESSAGE("Column Type: TIMESTAMP");
+#ifdef DEBUG_ON
+        DEBUGMESSAGE("Column Type: DATETIME/TIMESTAMP");
+#endif
 
+        Wt::WDateTime dateTime = decodeDateTime(columnValue, columnLength);
+
+        if (!dateTime.isNull())     // Zero date-times are returned as NULL.
+        {
+          returnValue = dateTime;
+        };
         break;
       }
-      case MYSQL_TYPE_DATE:         // Needed
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_NEWDATE:
       {
 #ifdef DEBUG_ON
         DEBUGMESSAGE("Column Type: DATE");
 #endif
 
-        returnValue = Wt::WDate::fromString(val, "yyyy-MM-dd");
+        Wt::WDate date = decodeDate(columnValue, columnLength);
+
+        if (!date.isNull())         // Zero dates are returned as NULL.
+        {
+          returnValue = date;
+        };
         break;
       }
-      case MYSQL_TYPE_TIME:         // Needed
+      case MYSQL_TYPE_TIME:
+      case MYSQL_TYPE_TIME2:
       {
 #ifdef DEBUG_ON
         DEBUGMESSAGE("Column Type: TIME");
 #endif
 
-        returnValue = Wt::WTime::fromString(val, "hh:mm:ss");
+        returnValue = decodeTime(columnValue, columnLength);
         break;
       }
-      case MYSQL_TYPE_DATETIME:     // Needed
+      case MYSQL_TYPE_YEAR:
       {
 #ifdef DEBUG_ON
-        DEBUGMESSAGE("Column Type: DATETIME");
+        DEBUGMESSAGE("Column Type: YEAR");
 #endif
 
-        returnValue = Wt::WDateTime::fromString(val, "yyyy-MM-dd hh:mm:ss");
+        returnValue = decodeYear(columnValue, columnLength);
         break;
       }
       case MYSQL_TYPE_BIT:          // Needed
@@ -850,11 +3070,6 @@ namespace database
         returnValue = decimal_t{val};
         break;
       }
-      case MYSQL_TYPE_YEAR:
-      case MYSQL_TYPE_NEWDATE:
-      case MYSQL_TYPE_TIMESTAMP2:
-      case MYSQL_TYPE_DATETIME2:
-      case MYSQL_TYPE_TIME2:
       case MYSQL_TYPE_JSON:
       case MYSQL_TYPE_ENUM:
       case MYSQL_TYPE_SET:
@@ -873,4 +3088,251 @@ namespace database
 
     return returnValue;
   }
+
+  /// @brief      Returns the bytes held by a STRING or BLOB value, without copying them.
+  /// @param[in]  value: The value. Must be a STRING or BLOB.
+  /// @returns    A view of the value's buffer. Valid while the value is unchanged.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::string_view CMariaDBConnector::variantBytes(CVariant const &value)
+  {
+      // The buffer accessor is non-const, but is only read here.
+
+    CVariant &variant = const_cast<CVariant &>(value);
+
+    return std::string_view(static_cast<char const *>(static_cast<void *>(variant)), variant.bufferLength());
+  }
+
+  /// @brief      Appends the text representation of a value to a string. This is the form the server accepts for the value in
+  ///             a text statement or a LOAD DATA stream. No quoting or escaping is applied.
+  /// @param[in]  value: The value to convert. Must not be NULL.
+  /// @param[out] text: The string to append to.
+  /// @throws
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::variantText(CVariant const &value, std::string &text)
+  {
+    char buffer[32];
+    std::to_chars_result result;
+
+    auto appendDigits = [&text](unsigned int number, std::size_t digits)
+    {
+      std::size_t position = text.size() + digits;
+      text.resize(position);
+      while (digits-- > 0)
+      {
+        text[--position] = static_cast<char>('0' + number % 10);
+        number /= 10;
+      }
+    };
+
+    auto appendDate = [&appendDigits, &text](Wt::WDate const &date)
+    {
+      appendDigits(date.year(), 4);
+      text += '-';
+      appendDigits(date.month(), 2);
+      text += '-';
+      appendDigits(date.day(), 2);
+    };
+
+    auto appendTime = [&appendDigits, &text](Wt::WTime const &time)
+    {
+      appendDigits(time.hour(), 2);
+      text += ':';
+      appendDigits(time.minute(), 2);
+      text += ':';
+      appendDigits(time.second(), 2);
+      if (time.msec() != 0)
+      {
+        text += '.';
+        appendDigits(time.msec(), 3);
+      }
+    };
+
+    switch (value.type())
+    {
+      case BIT:
+      {
+        text += std::to_string(static_cast<boost::dynamic_bitset<>>(value).to_ulong());
+        break;
+      }
+      case BLOB:
+      {
+        text += variantBytes(value);
+        break;
+      }
+      case U8:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::uint8_t>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case I8:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::int8_t>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case U16:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::uint16_t>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case I16:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::int16_t>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case U32:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::uint32_t>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case I32:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::int32_t>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case U64:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::uint64_t>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case I64:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<std::int64_t>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case FLOAT:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<float>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case DOUBLE:
+      {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<double>(value));
+        text.append(buffer, result.ptr);
+        break;
+      }
+      case STRING:
+      {
+        text += variantBytes(value);
+        break;
+      }
+      case DECIMAL:
+      {
+        text += static_cast<std::string>(value);
+        break;
+      }
+      case BOOL:
+      {
+        text += (static_cast<bool>(value) ? '1' : '0');
+        break;
+      }
+      case DATE:
+      {
+        appendDate(static_cast<Wt::WDate>(value));
+        break;
+      }
+      case TIME:
+      {
+        appendTime(static_cast<Wt::WTime>(value));
+        break;
+      }
+      case DATETIME:
+      {
+        Wt::WDateTime dateTime = static_cast<Wt::WDateTime>(value);
+
+        appendDate(dateTime.date());
+        text += ' ';
+        appendTime(dateTime.time());
+        break;
+      }
+      case NULLVALUE:
+      default:
+      {
+        CODE_ERROR();
+      }
+    };
+  }
+
+  /// @brief      Watchdog thread. Sleeps until the earliest query deadline and kills any query that is still running when its
+  ///             deadline passes. Only started once a timeout has been set. The handles are scanned and the kills sent without
+  ///             holding watchdogMutex, so queries arming and disarming deadlines are never held up by a kill.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CMariaDBConnector::watchdog()
+  {
+    threadAttach();
+
+    std::vector<std::pair<handle_t, std::uint64_t>> expired;
+    std::unique_lock<std::mutex> lock(watchdogMutex);
+
+    while (!watchdogStop)
+    {
+        // Any deadline armed from here until the scan result is published requests another scan.
+
+      watchdogRescan = false;
+      watchdogWake.store(INT64_MAX);
+      lock.unlock();
+
+      auto now = std::chrono::steady_clock::now();
+      auto nextDeadline = std::chrono::steady_clock::time_point::max();
+
+      expired.clear();
+      for (handle_t handle = 0; handle < connectionPool.size(); ++handle)
+      {
+        connectionCold_t &cold = *connectionPool[handle].cold;
+        std::lock_guard<std::mutex> handleLock(cold.deadlineMutex);
+
+        if (cold.queryDeadline <= now)
+        {
+          cold.queryDeadline = std::chrono::steady_clock::time_point::max();
+          expired.emplace_back(handle, cold.deadlineGeneration);
+        }
+        else
+        {
+          nextDeadline = std::min(nextDeadline, cold.queryDeadline);
+        };
+      };
+
+      for (auto const &[handle, generation] : expired)
+      {
+        if (!killQuery(handle, generation))
+        {
+            // Re-arm the deadline to retry the kill, unless the query has finished or a new deadline has been armed.
+
+          connectionCold_t &cold = *connectionPool[handle].cold;
+          std::lock_guard<std::mutex> handleLock(cold.deadlineMutex);
+
+          if (cold.deadlineGeneration == generation)
+          {
+            cold.queryDeadline = std::chrono::steady_clock::now() + KILL_RETRY_DELAY;
+            nextDeadline = std::min(nextDeadline, cold.queryDeadline);
+          };
+        };
+      };
+
+      lock.lock();
+      watchdogWake.store(nextDeadline.time_since_epoch().count());
+
+      auto woken = [this] { return watchdogStop || watchdogRescan; };
+
+      if (nextDeadline == std::chrono::steady_clock::time_point::max())
+      {
+        watchdogCondition.wait(lock, woken);
+      }
+      else
+      {
+        watchdogCondition.wait_until(lock, nextDeadline, woken);
+      };
+    };
+  }
 }
@@ -0,0 +1,192 @@
+﻿#include "include/exportSink.h"
+
+  // Standard C++ libraries
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+  // Linux
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+  // engineeringShop
+
+#include "include/database/database/pluginDatabase.h"
+
+namespace database
+{
+  /// @brief      Opens the file. An existing file is truncated.
+  /// @param[in]  fileName: The file to write.
+  /// @param[in]  direct: true to bypass the page cache with O_DIRECT.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  CFileExportSink::CFileExportSink(std::string const &fileName, bool direct) : directIO(direct),
+    buffer(static_cast<char *>(std::aligned_alloc(BLOCK_SIZE, BUFFER_SIZE)), &std::free)
+  {
+    if (!buffer)
+    {
+      RUNTIME_ERROR("Unable to allocate export buffer.");
+    };
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | (directIO ? O_DIRECT : 0);
+
+    if ((fileDescriptor = ::open(fileName.c_str(), flags, 0644)) < 0)
+    {
+      RUNTIME_ERROR("Unable to open " + fileName + ": " + std::strerror(errno));
+    };
+  }
+
+  /// @brief      Destructor. Writes any remaining data. Errors are ignored; call close() to see them.
+  /// @version    2026-10-19/GGB - Function created.
+
+  CFileExportSink::~CFileExportSink()
+  {
+    try
+    {
+      close();
+    }
+    catch(...)
+    {
+    }
+  }
+
+  /// @brief      Writes the remaining data and closes the file. The last partial block of a direct I/O file is written after
+  ///             turning O_DIRECT off.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CFileExportSink::close()
+  {
+    if (fileDescriptor >= 0)
+    {
+      flush();
+
+      if (bufferUsed != 0)
+      {
+        fcntl(fileDescriptor, F_SETFL, fcntl(fileDescriptor, F_GETFL) & ~O_DIRECT);
+        writeBuffer(bufferUsed);
+      };
+
+      int result = ::close(fileDescriptor);
+      fileDescriptor = -1;
+
+      if (result != 0)
+      {
+        RUNTIME_ERROR(std::string("Unable to close export file: ") + std::strerror(errno));
+      };
+    };
+  }
+
+  /// @brief      Writes the buffered data. With direct I/O only whole blocks are written and the remainder is kept.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CFileExportSink::flush()
+  {
+    writeBuffer(directIO ? bufferUsed - bufferUsed % BLOCK_SIZE : bufferUsed);
+  }
+
+  /// @brief      Appends data to the buffer. When the data will not fit, the buffer and the data are written together.
+  /// @param[in]  data: The data to write.
+  /// @param[in]  length: The length of the data.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CFileExportSink::write(char const *data, std::size_t length)
+  {
+    if (bufferUsed + length <= BUFFER_SIZE)
+    {
+      std::memcpy(buffer.get() + bufferUsed, data, length);
+      bufferUsed += length;
+    }
+    else if (!directIO)
+    {
+        // Gather the buffer and the new data into one system call.
+
+      iovec vector[2] = { { buffer.get(), bufferUsed }, { const_cast<char *>(data), length } };
+      std::size_t remaining = bufferUsed + length;
+
+      while (remaining != 0)
+      {
+        ssize_t written = ::writev(fileDescriptor, vector, 2);
+
+        if (written < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          };
+          RUNTIME_ERROR(std::string("Unable to write export file: ") + std::strerror(errno));
+        };
+
+        remaining -= written;
+        for (auto &element : vector)
+        {
+          std::size_t consumed = std::min<std::size_t>(element.iov_len, written);
+          element.iov_base = static_cast<char *>(element.iov_base) + consumed;
+          element.iov_len -= consumed;
+          written -= consumed;
+        };
+      };
+
+      bufferUsed = 0;
+    }
+    else
+    {
+        // O_DIRECT needs aligned buffers, so the data is passed through the buffer in blocks.
+
+      while (length != 0)
+      {
+        std::size_t count = std::min(length, BUFFER_SIZE - bufferUsed);
+
+        std::memcpy(buffer.get() + bufferUsed, data, count);
+        bufferUsed += count;
+        data += count;
+        length -= count;
+
+        if (bufferUsed == BUFFER_SIZE)
+        {
+          flush();
+        };
+      };
+    };
+  }
+
+  /// @brief      Writes the start of the buffer to the file and moves any remainder to the start of the buffer.
+  /// @param[in]  count: The number of bytes to write.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CFileExportSink::writeBuffer(std::size_t count)
+  {
+    std::size_t position = 0;
+
+    while (position < count)
+    {
+      ssize_t written = ::write(fileDescriptor, buffer.get() + position, count - position);
+
+      if (written < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        };
+        RUNTIME_ERROR(std::string("Unable to write export file: ") + std::strerror(errno));
+      };
+
+      position += written;
+    };
+
+    bufferUsed -= count;
+    if (bufferUsed != 0)
+    {
+      std::memmove(buffer.get(), buffer.get() + count, bufferUsed);
+    };
+  }
+
+} // namespace
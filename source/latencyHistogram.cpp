@@ -0,0 +1,131 @@
+﻿#include "include/latencyHistogram.h"
+
+  // Standard C++ libraries
+
+#include <bit>
+#include <cmath>
+
+namespace database
+{
+  /// @brief      Returns the bucket for a value. Values below SUB_BUCKETS have their own bucket; above that each power of two
+  ///             is split into SUB_BUCKETS linear buckets.
+  /// @param[in]  value: The value in nanoseconds.
+  /// @returns    The bucket index.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::size_t CLatencyHistogram::bucketIndex(std::uint64_t value)
+  {
+    if (value < SUB_BUCKETS)
+    {
+      return value;
+    }
+    else
+    {
+      std::size_t exponent = std::bit_width(value) - 1;                     // >= SUB_BUCKET_BITS
+      std::size_t shift = exponent - SUB_BUCKET_BITS;
+      std::size_t subBucket = (value >> shift) & (SUB_BUCKETS - 1);
+
+      return (shift + 1) * SUB_BUCKETS + subBucket;
+    };
+  }
+
+  /// @brief      Returns the upper limit of a bucket.
+  /// @param[in]  index: The bucket index.
+  /// @returns    The largest value counted in the bucket.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::uint64_t CLatencyHistogram::bucketValue(std::size_t index)
+  {
+    if (index < SUB_BUCKETS)
+    {
+      return index;
+    }
+    else
+    {
+      std::size_t shift = index / SUB_BUCKETS - 1;
+      std::uint64_t subBucket = index % SUB_BUCKETS;
+
+      return ((SUB_BUCKETS + subBucket + 1) << shift) - 1;
+    };
+  }
+
+  /// @brief      Returns the number of values recorded.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::uint64_t CLatencyHistogram::count() const
+  {
+    std::uint64_t returnValue = 0;
+
+    for (auto const &bucket : buckets)
+    {
+      returnValue += bucket.load(std::memory_order_relaxed);
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Returns a percentile of the recorded values.
+  /// @param[in]  fraction: The percentile as a fraction. (0.5, 0.99, 0.999 etc)
+  /// @returns    The upper limit of the bucket containing the percentile. Zero if nothing has been recorded.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::chrono::nanoseconds CLatencyHistogram::percentile(double fraction) const
+  {
+    std::array<std::uint64_t, BUCKET_COUNT> counts;
+    std::uint64_t total = 0;
+
+    for (std::size_t index = 0; index < BUCKET_COUNT; ++index)
+    {
+      counts[index] = buckets[index].load(std::memory_order_relaxed);
+      total += counts[index];
+    };
+
+    if (total == 0)
+    {
+      return std::chrono::nanoseconds(0);
+    };
+
+    std::uint64_t target = static_cast<std::uint64_t>(std::ceil(fraction * total));
+    std::uint64_t cumulative = 0;
+
+    for (std::size_t index = 0; index < BUCKET_COUNT; ++index)
+    {
+      cumulative += counts[index];
+      if ((cumulative >= target) && (cumulative != 0))
+      {
+        return std::chrono::nanoseconds(std::min(bucketValue(index), maximum.load(std::memory_order_relaxed)));
+      };
+    };
+
+    return max();
+  }
+
+  /// @brief      Records a value.
+  /// @param[in]  latency: The value to record.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CLatencyHistogram::record(std::chrono::nanoseconds latency)
+  {
+    std::uint64_t value = (latency.count() > 0) ? static_cast<std::uint64_t>(latency.count()) : 0;
+    std::uint64_t current = maximum.load(std::memory_order_relaxed);
+
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+
+    while ((value > current) && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    };
+  }
+
+  /// @brief      Clears the recorded values.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CLatencyHistogram::reset()
+  {
+    for (auto &bucket : buckets)
+    {
+      bucket.store(0, std::memory_order_relaxed);
+    };
+    maximum.store(0, std::memory_order_relaxed);
+  }
+
+} // namespace
@@ -41,4 +41,21 @@ namespace pluginInterface
     delete toDelete;
   }
 
+  /// @brief Attaches the calling thread to the client library. Optional, threads are attached on first use.
+  /// @throws
+  /// @version 2026-10-19/GGB - Function created.
+
+  void threadAttach()
+  {
+    database::CMariaDBConnector::threadAttach();
+  }
+
+  /// @brief Detaches the calling thread from the client library. Optional, attached threads are detached when they exit.
+  /// @version 2026-10-19/GGB - Function created.
+
+  void threadDetach()
+  {
+    database::CMariaDBConnector::threadDetach();
+  }
+
 } // namespace
@@ -0,0 +1,306 @@
+﻿#include "include/rowStore.h"
+
+  // Standard C++ libraries
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+  // Linux
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+  // engineeringShop
+
+#include "include/database/database/pluginDatabase.h"
+
+namespace database
+{
+  static constexpr std::size_t MEMORY_MINIMUM = 64 * 1024;
+  static constexpr std::size_t MAP_GRANULARITY = 1024 * 1024;
+  static constexpr std::size_t VARINT_MAXIMUM = 10;
+
+  /// @brief      Constructor.
+  /// @param[in]  pool: The counter of memory held by all the row stores of the pool.
+  /// @version    2026-10-19/GGB - Function created.
+
+  CRowStore::CRowStore(std::atomic<std::size_t> &pool) : poolMemory(pool)
+  {
+  }
+
+  /// @brief      Destructor. Releases the memory and the temporary file.
+  /// @version    2026-10-19/GGB - Function created.
+
+  CRowStore::~CRowStore()
+  {
+    clear();
+  }
+
+  /// @brief      Appends a row.
+  /// @param[in]  values: The column values. nullptr for NULL.
+  /// @param[in]  lengths: The column lengths.
+  /// @param[in]  columnCount: The number of columns.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::append(char const * const *values, unsigned long const *lengths, unsigned int columnCount)
+  {
+    std::size_t rowSize = 0;
+
+    for (unsigned int columnIndex = 0; columnIndex < columnCount; ++columnIndex)
+    {
+      rowSize += VARINT_MAXIMUM + (values[columnIndex] ? lengths[columnIndex] + 1 : 0);
+    };
+
+      // Both are reserved before writing, as either may spill the store and move the other.
+
+    reserve(rowData, rowData.used + rowSize);
+    reserve(rowOffsets, rowOffsets.used + sizeof(std::uint64_t));
+
+    char *base = rowData.data();
+    char *write = base + rowData.used;
+
+    for (unsigned int columnIndex = 0; columnIndex < columnCount; ++columnIndex)
+    {
+      std::uint64_t value = values[columnIndex] ? static_cast<std::uint64_t>(lengths[columnIndex]) + 1 : 0;
+
+      do
+      {
+        *write = static_cast<char>(value & 0x7F);
+        value >>= 7;
+        *write++ |= (value != 0) ? 0x80 : 0;
+      }
+      while (value != 0);
+
+      if (values[columnIndex])
+      {
+        std::memcpy(write, values[columnIndex], lengths[columnIndex]);
+        write += lengths[columnIndex];
+        *write++ = '\0';
+      };
+    };
+
+    std::uint64_t offset = rowData.used;
+
+    std::memcpy(rowOffsets.data() + rowOffsets.used, &offset, sizeof(offset));
+    rowOffsets.used += sizeof(offset);
+    rowData.used = write - base;
+  }
+
+  /// @brief      Releases the rows, the memory and the temporary files.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::clear()
+  {
+    release(rowData);
+    release(rowOffsets);
+  }
+
+  /// @brief      Extends the temporary file of an area and maps it again. The blocks are allocated with posix_fallocate() so
+  ///             that a full disk is reported here rather than as a SIGBUS when the mapping is written.
+  /// @param[in]  area: The area to extend.
+  /// @param[in]  required: The size needed.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::growMap(area_t &area, std::size_t required)
+  {
+    std::size_t newSize = std::max({required, area.mapSize * 2, MAP_GRANULARITY});
+
+    newSize = (newSize + MAP_GRANULARITY - 1) / MAP_GRANULARITY * MAP_GRANULARITY;
+
+    if (int error = posix_fallocate(area.fileDescriptor, area.mapSize, newSize - area.mapSize))
+    {
+      RUNTIME_ERROR(std::string("Unable to extend result spill file: ") + std::strerror(error));
+    };
+
+    if (area.map)
+    {
+      munmap(area.map, area.mapSize);
+      area.map = nullptr;
+    };
+
+    void *newMap = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, area.fileDescriptor, 0);
+
+    if (newMap == MAP_FAILED)
+    {
+      RUNTIME_ERROR(std::string("Unable to map result spill file: ") + std::strerror(errno));
+    };
+
+    area.map = static_cast<char *>(newMap);
+    area.mapSize = newSize;
+  }
+
+  /// @brief      Releases the memory and the temporary file of an area.
+  /// @param[in]  area: The area to release.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::release(area_t &area)
+  {
+    area.used = 0;
+
+    if (area.memory)
+    {
+      area.memory.reset();
+      poolMemory.fetch_sub(area.memorySize, std::memory_order_relaxed);
+      area.memorySize = 0;
+    };
+
+    if (area.map)
+    {
+      munmap(area.map, area.mapSize);
+      area.map = nullptr;
+      area.mapSize = 0;
+    };
+
+    if (area.fileDescriptor >= 0)
+    {
+      ::close(area.fileDescriptor);
+      area.fileDescriptor = -1;
+    };
+  }
+
+  /// @brief      Ensures an area has space for the data. The memory of the areas grows geometrically up to the limits, which
+  ///             apply to both areas together. After that the store is spilled.
+  /// @param[in]  area: The area to grow.
+  /// @param[in]  required: The total size needed in the area.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::reserve(area_t &area, std::size_t required)
+  {
+    if (spilled())
+    {
+      if (required > area.mapSize)
+      {
+        growMap(area, required);
+      };
+    }
+    else if (required > area.memorySize)
+    {
+      std::size_t available = memoryLimit - (rowData.memorySize + rowOffsets.memorySize);
+      std::size_t growth = std::min(std::max({required, area.memorySize * 2, MEMORY_MINIMUM}) - area.memorySize, available);
+      bool withinBudget = (required - area.memorySize <= available);
+
+      if (withinBudget && (poolMemory.fetch_add(growth, std::memory_order_relaxed) + growth > poolLimit))
+      {
+        poolMemory.fetch_sub(growth, std::memory_order_relaxed);
+        withinBudget = false;
+      };
+
+      if (!withinBudget)
+      {
+        spill(area, required);
+      }
+      else
+      {
+        std::unique_ptr<char[]> newMemory(new char[area.memorySize + growth]);
+
+        if (area.used != 0)
+        {
+          std::memcpy(newMemory.get(), area.memory.get(), area.used);
+        };
+        area.memory = std::move(newMemory);
+        area.memorySize += growth;
+      };
+    };
+  }
+
+  /// @brief      Sets the limits and clears the store for a new result.
+  /// @param[in]  resultLimit: The memory that may be used for this result. SIZE_MAX for no limit.
+  /// @param[in]  pool: The memory that may be used by all the results of the pool. SIZE_MAX for no limit.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::reset(std::size_t resultLimit, std::size_t pool)
+  {
+    clear();
+    memoryLimit = resultLimit;
+    poolLimit = pool;
+  }
+
+  /// @brief      Returns the values of a row. The pointers remain valid until the next append() or clear().
+  /// @param[in]  rowIndex: The row to return.
+  /// @param[in]  columnCount: The number of columns.
+  /// @param[out] values: The column values. nullptr for NULL.
+  /// @param[out] lengths: The column lengths.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::row(std::uint64_t rowIndex, unsigned int columnCount, char **values, unsigned long *lengths) const
+  {
+    std::uint64_t offset;
+
+    std::memcpy(&offset, rowOffsets.data() + rowIndex * sizeof(offset), sizeof(offset));
+
+    char *read = rowData.data() + offset;
+
+    for (unsigned int columnIndex = 0; columnIndex < columnCount; ++columnIndex)
+    {
+      std::uint64_t value = 0;
+      unsigned int shift = 0;
+
+      do
+      {
+        value |= static_cast<std::uint64_t>(*read & 0x7F) << shift;
+        shift += 7;
+      }
+      while (*read++ & 0x80);
+
+      if (value == 0)
+      {
+        values[columnIndex] = nullptr;
+        lengths[columnIndex] = 0;
+      }
+      else
+      {
+        values[columnIndex] = read;
+        lengths[columnIndex] = value - 1;
+        read += value;                  // The bytes and the terminating NUL.
+      };
+    };
+  }
+
+  /// @brief      Moves the data and the row index to temporary files. The space already reserved in each area is kept.
+  /// @param[in]  area: The area that needs to grow.
+  /// @param[in]  required: The total size needed in that area.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::spill(area_t &area, std::size_t required)
+  {
+    spillArea(rowData, (&area == &rowData) ? required : rowData.memorySize);
+    spillArea(rowOffsets, (&area == &rowOffsets) ? required : rowOffsets.memorySize);
+  }
+
+  /// @brief      Moves an area to an unlinked temporary file in $TMPDIR (or /tmp) and releases its memory.
+  /// @param[in]  area: The area to move.
+  /// @param[in]  required: The size needed in the file.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CRowStore::spillArea(area_t &area, std::size_t required)
+  {
+    char const *directory = std::getenv("TMPDIR");
+    std::string fileName = std::string((directory && *directory) ? directory : "/tmp") + "/mariadbResultXXXXXX";
+
+    if ((area.fileDescriptor = mkostemp(fileName.data(), O_CLOEXEC)) < 0)
+    {
+      RUNTIME_ERROR("Unable to create result spill file " + fileName + ": " + std::strerror(errno));
+    };
+    unlink(fileName.c_str());
+
+    growMap(area, std::max({required, area.memorySize, area.used * 2}));
+
+    if (area.used != 0)
+    {
+      std::memcpy(area.map, area.memory.get(), area.used);
+    };
+    area.memory.reset();
+    poolMemory.fetch_sub(area.memorySize, std::memory_order_relaxed);
+    area.memorySize = 0;
+  }
+
+} // namespace
@@ -0,0 +1,98 @@
+﻿#include "include/slowQueryLog.h"
+
+  // Standard C++ libraries
+
+#include <algorithm>
+#include <cstring>
+
+namespace database
+{
+  /// @brief      Constructor.
+  /// @param[in]  size: The number of entries retained.
+  /// @version    2026-10-19/GGB - Function created.
+
+  CSlowQueryLog::CSlowQueryLog(std::size_t size) : slots(std::make_unique<slot_t[]>(std::max<std::size_t>(size, 1))),
+    capacity(std::max<std::size_t>(size, 1))
+  {
+  }
+
+  /// @brief      Returns a copy of the entries currently in the buffer, oldest first. Slots that are being rewritten while they
+  ///             are copied are skipped.
+  /// @returns    The entries.
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::vector<CSlowQueryLog::entry_t> CSlowQueryLog::entries() const
+  {
+    std::vector<entry_t> returnValue;
+    std::uint64_t last = writeIndex.load(std::memory_order_acquire);
+    std::uint64_t first = (last > capacity) ? last - capacity : 0;
+
+    returnValue.reserve(last - first);
+
+    for (std::uint64_t index = first; index < last; ++index)
+    {
+      slot_t const &slot = slots[index % capacity];
+      std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+      if (sequence != 2 * index + 2)
+      {
+        continue;                   // Being written, or already overwritten by a later entry.
+      };
+
+      entry_t entry;
+      entry.startTime = slot.startTime;
+      entry.executeTime = slot.executeTime;
+      entry.fetchTime = slot.fetchTime;
+      entry.rowCount = slot.rowCount;
+      entry.sql.assign(slot.sql, std::min<std::size_t>(slot.sqlLength, SQL_LENGTH));
+      entry.parameterTypes.assign(slot.parameterTypes, std::min<std::size_t>(slot.parameterLength, PARAMETER_LENGTH));
+      entry.explain.assign(slot.explain, std::min<std::size_t>(slot.explainLength, EXPLAIN_LENGTH));
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+      {
+        returnValue.push_back(std::move(entry));
+      };
+    };
+
+    return returnValue;
+  }
+
+  /// @brief      Records an entry. The strings are truncated to the slot size. The slot is claimed by moving its sequence from
+  ///             an even (published) value to odd, so two writers that wrap onto the same slot can never write it together.
+  ///             The entry is dropped if the slot is being written or already holds a later entry.
+  /// @param[in]  entry: The entry to record.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CSlowQueryLog::record(entry_t const &entry)
+  {
+    std::uint64_t index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+    slot_t &slot = slots[index % capacity];
+    std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+    do
+    {
+      if ((sequence & 1) || (sequence > 2 * index))
+      {
+        return;
+      };
+    }
+    while (!slot.sequence.compare_exchange_weak(sequence, 2 * index + 1, std::memory_order_relaxed));
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.startTime = entry.startTime;
+    slot.executeTime = entry.executeTime;
+    slot.fetchTime = entry.fetchTime;
+    slot.rowCount = entry.rowCount;
+    slot.sqlLength = static_cast<std::uint16_t>(std::min(entry.sql.size(), SQL_LENGTH));
+    std::memcpy(slot.sql, entry.sql.data(), slot.sqlLength);
+    slot.parameterLength = static_cast<std::uint16_t>(std::min(entry.parameterTypes.size(), PARAMETER_LENGTH));
+    std::memcpy(slot.parameterTypes, entry.parameterTypes.data(), slot.parameterLength);
+    slot.explainLength = static_cast<std::uint16_t>(std::min(entry.explain.size(), EXPLAIN_LENGTH));
+    std::memcpy(slot.explain, entry.explain.data(), slot.explainLength);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+  }
+
+} // namespace
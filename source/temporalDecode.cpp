@@ -0,0 +1,191 @@
+﻿#include "include/temporalDecode.h"
+
+  // engineeringShop
+
+#include "include/database/database/pluginDatabase.h"
+
+namespace database
+{
+  /// @brief      Converts a fixed number of decimal digits.
+  /// @param[in]  text: The first digit.
+  /// @param[in]  count: The number of digits.
+  /// @param[out] value: The value of the digits.
+  /// @returns    false if any of the characters are not digits.
+  /// @version    2026-10-19/GGB - Function created.
+
+  static bool decodeDigits(char const *text, std::size_t count, unsigned int &value)
+  {
+    value = 0;
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+      unsigned int digit = static_cast<unsigned char>(text[index]) - '0';
+
+      if (digit > 9)
+      {
+        return false;
+      };
+
+      value = value * 10 + digit;
+    };
+
+    return true;
+  }
+
+  /// @brief      Converts the optional fractional seconds (.f to .ffffff) to milliseconds.
+  /// @param[in]  text: The character after the seconds.
+  /// @param[in]  length: The number of characters remaining.
+  /// @param[out] milliSeconds: The fraction, truncated to milliseconds.
+  /// @returns    false if the fraction is malformed.
+  /// @version    2026-10-19/GGB - Function created.
+
+  static bool decodeFraction(char const *text, std::size_t length, unsigned int &milliSeconds)
+  {
+    milliSeconds = 0;
+
+    if (length == 0)
+    {
+      return true;
+    }
+    else if ((text[0] != '.') || (length < 2) || (length > 7))
+    {
+      return false;
+    }
+    else
+    {
+      unsigned int fraction;
+      std::size_t digits = length - 1;
+
+      if (!decodeDigits(text + 1, digits, fraction))
+      {
+        return false;
+      };
+
+      for (; digits < 3; ++digits)
+      {
+        fraction *= 10;
+      };
+      for (; digits > 3; --digits)
+      {
+        fraction /= 10;
+      };
+
+      milliSeconds = fraction;
+      return true;
+    };
+  }
+
+  /// @brief      Decodes a DATE value. (YYYY-MM-DD)
+  /// @param[in]  text: The column value.
+  /// @param[in]  length: The length of the column value.
+  /// @returns    The date. A null date for the zero date.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  Wt::WDate decodeDate(char const *text, std::size_t length)
+  {
+    unsigned int year, month, day;
+
+    if ((length != 10) || (text[4] != '-') || (text[7] != '-') ||
+        !decodeDigits(text, 4, year) || !decodeDigits(text + 5, 2, month) || !decodeDigits(text + 8, 2, day))
+    {
+      RUNTIME_ERROR("Invalid DATE value: " + std::string(text, length));
+    };
+
+    if ((year == 0) && (month == 0) && (day == 0))
+    {
+      return Wt::WDate();
+    }
+    else
+    {
+      return Wt::WDate(year, month, day);
+    };
+  }
+
+  /// @brief      Decodes a DATETIME or TIMESTAMP value. (YYYY-MM-DD hh:mm:ss[.ffffff])
+  /// @param[in]  text: The column value.
+  /// @param[in]  length: The length of the column value.
+  /// @returns    The date-time. A null date-time for the zero date.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  Wt::WDateTime decodeDateTime(char const *text, std::size_t length)
+  {
+    unsigned int hour, minute, second, milliSeconds;
+
+    if ((length < 19) || (text[10] != ' ') || (text[13] != ':') || (text[16] != ':') ||
+        !decodeDigits(text + 11, 2, hour) || !decodeDigits(text + 14, 2, minute) || !decodeDigits(text + 17, 2, second) ||
+        !decodeFraction(text + 19, length - 19, milliSeconds))
+    {
+      RUNTIME_ERROR("Invalid DATETIME value: " + std::string(text, length));
+    };
+
+    Wt::WDate date = decodeDate(text, 10);
+
+    if (date.isNull())
+    {
+      return Wt::WDateTime();
+    }
+    else
+    {
+      return Wt::WDateTime(date, Wt::WTime(hour, minute, second, milliSeconds));
+    };
+  }
+
+  /// @brief      Decodes a TIME value. ([-]h[hh]:mm:ss[.ffffff])
+  /// @param[in]  text: The column value.
+  /// @param[in]  length: The length of the column value.
+  /// @returns    The time.
+  /// @throws     std::runtime_error if the value is malformed, or is not a time of day. TIME columns hold intervals of up to
+  ///             +-838 hours, which Wt::WTime cannot represent.
+  /// @version    2026-10-19/GGB - Function created.
+
+  Wt::WTime decodeTime(char const *text, std::size_t length)
+  {
+    bool negative = (length != 0) && (text[0] == '-');
+    std::size_t position = negative ? 1 : 0;
+    std::size_t hourDigits = 0;
+
+    while ((position + hourDigits < length) && (text[position + hourDigits] != ':'))
+    {
+      ++hourDigits;
+    };
+
+    unsigned int hour, minute, second, milliSeconds;
+    std::size_t const secondsEnd = position + hourDigits + 6;
+
+    if ((hourDigits < 1) || (hourDigits > 3) || (length < secondsEnd) || (text[secondsEnd - 3] != ':') ||
+        !decodeDigits(text + position, hourDigits, hour) || !decodeDigits(text + secondsEnd - 5, 2, minute) ||
+        !decodeDigits(text + secondsEnd - 2, 2, second) || !decodeFraction(text + secondsEnd, length - secondsEnd, milliSeconds))
+    {
+      RUNTIME_ERROR("Invalid TIME value: " + std::string(text, length));
+    };
+
+    if (negative || (hour > 23))
+    {
+      RUNTIME_ERROR("TIME value is not a time of day: " + std::string(text, length));
+    };
+
+    return Wt::WTime(hour, minute, second, milliSeconds);
+  }
+
+  /// @brief      Decodes a YEAR value. (YYYY)
+  /// @param[in]  text: The column value.
+  /// @param[in]  length: The length of the column value.
+  /// @returns    The year. 0 for the zero year.
+  /// @throws     std::runtime_error
+  /// @version    2026-10-19/GGB - Function created.
+
+  std::uint16_t decodeYear(char const *text, std::size_t length)
+  {
+    unsigned int year;
+
+    if ((length != 4) || !decodeDigits(text, 4, year))
+    {
+      RUNTIME_ERROR("Invalid YEAR value: " + std::string(text, length));
+    };
+
+    return static_cast<std::uint16_t>(year);
+  }
+
+} // namespace
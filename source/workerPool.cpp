@@ -0,0 +1,113 @@
+﻿#include "include/workerPool.h"
+
+  // Standard C++ libraries
+
+#include <algorithm>
+
+namespace database
+{
+  /// @brief      Constructor. Starts the worker threads.
+  /// @param[in]  threadCount: The number of worker threads.
+  /// @version    2026-10-19/GGB - Function created.
+
+  CWorkerPool::CWorkerPool(std::size_t threadCount)
+  {
+    threads.reserve(threadCount);
+    for (std::size_t index = 0; index < threadCount; ++index)
+    {
+      threads.emplace_back(&CWorkerPool::worker, this);
+    };
+  }
+
+  /// @brief      Destructor. Stops the worker threads. There must be no job running.
+  /// @version    2026-10-19/GGB - Function created.
+
+  CWorkerPool::~CWorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    condition.notify_all();
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    };
+  }
+
+  /// @brief      Runs task(0) .. task(taskCount - 1) on the workers and the calling thread, and returns when all have completed.
+  /// @param[in]  taskCount: The number of tasks.
+  /// @param[in]  task: Called with the index of each task.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CWorkerPool::run(std::size_t taskCount, std::function<void(std::size_t)> const &task)
+  {
+    job_t job(task, taskCount);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      jobs.push_back(&job);
+    }
+    condition.notify_all();
+
+    std::size_t completed = 0;
+
+    for (std::size_t index; (index = job.nextTask.fetch_add(1)) < taskCount; )
+    {
+      task(index);
+      ++completed;
+    };
+
+      // All the tasks have been taken. Withdraw the job so no worker picks it up again, then wait for the workers still
+      // running tasks of this job.
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto iterator = std::find(jobs.begin(), jobs.end(), &job);
+    if (iterator != jobs.end())
+    {
+      jobs.erase(iterator);
+    };
+
+    job.completed += completed;
+    job.finished.wait(lock, [&job] { return job.completed == job.taskCount; });
+  }
+
+  /// @brief      Worker thread. Takes tasks from the oldest job until the pool is stopped.
+  /// @version    2026-10-19/GGB - Function created.
+
+  void CWorkerPool::worker()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;)
+    {
+      condition.wait(lock, [this] { return stop || !jobs.empty(); });
+
+      if (stop)
+      {
+        break;
+      };
+
+      job_t &job = *jobs.front();
+      std::size_t index = job.nextTask.fetch_add(1);
+
+      if (index >= job.taskCount)
+      {
+        jobs.pop_front();           // Every task has been taken.
+        continue;
+      };
+
+      lock.unlock();
+      job.task(index);
+      lock.lock();
+
+      if (++job.completed == job.taskCount)
+      {
+        job.finished.notify_one();
+      };
+    };
+  }
+
+} // namespace